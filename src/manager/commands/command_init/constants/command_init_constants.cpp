@@ -8,8 +8,21 @@
 
 std::string const SpecificationConstants::SPECIFICATION_FILENAME = "specification.scs";
 std::string const SpecificationConstants::DIRECTORY_DELIMETR = "/";
+std::string const SpecificationConstants::MANIFEST_FILENAME = ".specifications_manifest";
+std::string const SpecificationConstants::COMPONENTS_MANIFEST_FILENAME = ".components_manifest";
+std::string const SpecificationConstants::MIRRORS_FILENAME = ".mirrors_statistics";
+std::string const SpecificationConstants::INDEX_FILENAME = "specifications.index";
+std::string const SpecificationConstants::INDEXES_DIRECTORY = ".indexes";
+std::string const SpecificationConstants::CACHE_DIRECTORY = ".cache";
+std::string const SpecificationConstants::OBJECTS_DIRECTORY = "objects";
+std::string const SpecificationConstants::STAGING_DIRECTORY = "staging";
+std::string const SpecificationConstants::SCS_CACHE_DIRECTORY = "scs";
+std::string const SpecificationConstants::SCS_EXTENSION = ".scs";
+std::string const SpecificationConstants::LOAD_INDEX_FILENAME = "load_index";
+std::string const SpecificationConstants::INSTALL_HISTORY_FILENAME = ".install_history";
+std::string const SpecificationConstants::COMPONENTS_REGISTRY_FILENAME = ".components_registry";
 
-std::string const GitHubConstants::SVN_TRUNK = "/trunk";
+std::string const GitHubConstants::GIT_CACHE_DIRECTORY = "git";
 std::string const GitHubConstants::GITHUB_PREFIX = "https://github.com/";
 
 std::string const GoogleDriveConstants::GOOGLE_DRIVE_PREFIX = "https://drive.google.com/";
@@ -13,6 +13,19 @@ class SpecificationConstants
 public:
   static std::string const SPECIFICATION_FILENAME;
   static std::string const DIRECTORY_DELIMETR;
+  static std::string const MANIFEST_FILENAME;
+  static std::string const COMPONENTS_MANIFEST_FILENAME;
+  static std::string const MIRRORS_FILENAME;
+  static std::string const INDEX_FILENAME;
+  static std::string const INDEXES_DIRECTORY;
+  static std::string const CACHE_DIRECTORY;
+  static std::string const OBJECTS_DIRECTORY;
+  static std::string const STAGING_DIRECTORY;
+  static std::string const SCS_CACHE_DIRECTORY;
+  static std::string const SCS_EXTENSION;
+  static std::string const LOAD_INDEX_FILENAME;
+  static std::string const INSTALL_HISTORY_FILENAME;
+  static std::string const COMPONENTS_REGISTRY_FILENAME;
 };
 
 class GoogleDriveConstants
@@ -27,6 +40,6 @@ public:
 class GitHubConstants
 {
 public:
-  static std::string const SVN_TRUNK;
+  static std::string const GIT_CACHE_DIRECTORY;
   static std::string const GITHUB_PREFIX;
 };
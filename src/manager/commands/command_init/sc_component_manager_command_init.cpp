@@ -4,84 +4,543 @@
  * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
  */
 
+#include <cstdio>
+#include <fstream>
+
 #include <sc-agents-common/utils/IteratorUtils.hpp>
 
 #include "src/manager/commands/sc_component_manager_command.hpp"
 #include "src/manager/downloader/downloader_handler.hpp"
 #include "src/manager/commands/command_init/sc_component_manager_command_init.hpp"
+#include "src/manager/utils/hasher.hpp"
+#include "src/manager/utils/repository_index.hpp"
 #include "src/manager/utils/sc_component_utils.hpp"
+#include "src/manager/utils/scs_batch_loader.hpp"
 
 ExecutionResult ScComponentManagerCommandInit::Execute(
     ScMemoryContext * context,
     CommandParameters const & commandParameters)
 {
-  ScAddrVector processedRepositories;
+  ExecutionResult executionResult;
+
+  m_visitedNodes.clear();
+  m_downloadedUrls.clear();
+  m_graph.clear();
+  m_savedDownloadsCount = 0;
+  m_isIncremental = commandParameters.count(PARAMETER_INCREMENTAL);
+  m_manifest.Load();
+
+  m_fetchedSpecifications =
+      std::make_unique<componentUtils::BlockingQueue<FetchedSpecification>>(kPipelineQueueCapacity);
+  m_parsedSpecifications =
+      std::make_unique<componentUtils::BlockingQueue<ParsedSpecification>>(kPipelineQueueCapacity);
+  m_pendingSpecificationsCount = 0;
 
-  ScAddrVector availableRepositories = utils::IteratorUtils::getAllWithType(
+  ScAddrVector const availableRepositories = utils::IteratorUtils::getAllWithType(
       context, keynodes::ScComponentManagerKeynodes::concept_repository, ScType::NodeConst);
 
-  ProcessRepositories(context, availableRepositories);
+  std::queue<ScAddr> repositoriesQueue;
+  for (ScAddr const & repository : availableRepositories)
+  {
+    if (m_visitedNodes.insert(repository).second)
+      repositoriesQueue.push(repository);
+  }
 
-  ExecutionResult executionResult;
+  // Specifications are downloaded and parsed by workers, but only this thread
+  // uses sc-memory: it applies parsed specifications and traverses repositories
+  componentUtils::ThreadPool downloadPool(m_downloadThreadsCount);
+  componentUtils::ThreadPool parsePool(m_parseThreadsCount);
+  for (size_t i = 0; i < parsePool.GetThreadsCount(); ++i)
+  {
+    parsePool.Submit([this]() {
+      ParseSpecifications();
+    });
+  }
+
+  try
+  {
+    ProcessRepositories(context, downloadPool, repositoriesQueue);
+    ParsedSpecification specification;
+    while (m_pendingSpecificationsCount > 0 && m_parsedSpecifications->Pop(specification))
+    {
+      --m_pendingSpecificationsCount;
+      try
+      {
+        ApplySpecification(context, specification, repositoriesQueue);
+      }
+      catch (std::exception const & exception)
+      {
+        SC_LOG_ERROR("ScComponentManagerCommandInit: Specification isn't applied. " + std::string(exception.what()));
+      }
+      ProcessRepositories(context, downloadPool, repositoriesQueue);
+    }
+  }
+  catch (...)
+  {
+    // Workers wait on queues until they are closed, otherwise pools can't be destroyed
+    m_fetchedSpecifications->Close();
+    m_parsedSpecifications->Close();
+    throw;
+  }
+
+  m_fetchedSpecifications->Close();
+  parsePool.Wait();
+
+  m_manifest.Save();
+
+  ExecutionResult const cycles = FindCycles(context);
+  for (std::string const & cycle : cycles)
+    SC_LOG_WARNING("ScComponentManagerCommandInit: " + cycle);
+  executionResult.insert(executionResult.cend(), cycles.cbegin(), cycles.cend());
+
+  SC_LOG_INFO(
+      "ScComponentManagerCommandInit: " + std::to_string(m_savedDownloadsCount) +
+      " repeated downloads of specifications are skipped");
+  SC_LOG_INFO(
+      "ScComponentManagerCommandInit: fetch -> parse queue: " + m_fetchedSpecifications->GetStatistics().ToString());
+  SC_LOG_INFO(
+      "ScComponentManagerCommandInit: parse -> apply queue: " + m_parsedSpecifications->GetStatistics().ToString());
+  SC_LOG_INFO("ScComponentManagerCommandInit: downloads: " + downloaderHandler->GetStatistics().ToString());
 
   return executionResult;
 }
 
 /**
- * @brief Recursivly iterates through repositories
- * and download avaible components specifications.
+ * @brief Process all queued repositories: find their components
+ * specifications and submit them to fetch stage of pipeline.
  * @param context current sc-memory context
- * @param avaibleRepositories vector of avaible repositories addrs
+ * @param downloadPool pool of workers that download specifications
+ * @param repositoriesQueue queue of repositories addrs, it is empty after call
  */
-void ScComponentManagerCommandInit::ProcessRepositories(ScMemoryContext * context, ScAddrVector & availableRepositories)
+void ScComponentManagerCommandInit::ProcessRepositories(
+    ScMemoryContext * context,
+    componentUtils::ThreadPool & downloadPool,
+    std::queue<ScAddr> & repositoriesQueue)
 {
-  if (availableRepositories.empty())
+  while (!repositoriesQueue.empty())
+  {
+    ScAddr const repository = repositoriesQueue.front();
+    repositoriesQueue.pop();
+
+    ScAddrVector currentRepositoriesAddrs;
+    try
+    {
+      currentRepositoriesAddrs = GetSpecificationsAddrs(
+          context, repository, keynodes::ScComponentManagerKeynodes::rrel_repositories_specifications);
+    }
+    catch (utils::ScException const & exception)
+    {
+      SC_LOG_DEBUG("Problem getting repositories specifications");
+      SC_LOG_DEBUG(exception.Message());
+    }
+
+    for (ScAddr const & currentRepositoryAddr : currentRepositoriesAddrs)
+      VisitNode(repository, currentRepositoryAddr, repositoriesQueue);
+
+    ScAddrVector currentComponentsSpecificationsAddrs;
+    try
+    {
+      currentComponentsSpecificationsAddrs = GetSpecificationsAddrs(
+          context, repository, keynodes::ScComponentManagerKeynodes::rrel_components_specifications);
+    }
+    catch (utils::ScException const & exception)
+    {
+      SC_LOG_DEBUG("Problem getting component specifications");
+      SC_LOG_DEBUG(exception.Message());
+    }
+
+    ScAddrVector newComponentsSpecificationsAddrs;
+    for (ScAddr const & componentSpecificationAddr : currentComponentsSpecificationsAddrs)
+    {
+      m_graph[repository].push_back(componentSpecificationAddr);
+      if (m_visitedNodes.insert(componentSpecificationAddr).second)
+        newComponentsSpecificationsAddrs.push_back(componentSpecificationAddr);
+      else
+        ++m_savedDownloadsCount;
+    }
+
+    SubmitSpecifications(context, downloadPool, repository, newComponentsSpecificationsAddrs);
+  }
+}
+
+/**
+ * @brief Submit components specifications of repository to fetch stage of pipeline.
+ * If repository has address, then its index is fetched and specifications
+ * that aren't found in index are downloaded separately.
+ * @param context current sc-memory context
+ * @param downloadPool pool of workers that download specifications
+ * @param repositoryAddr sc-addr of repository
+ * @param specificationsAddrs sc-addrs of not visited specifications of repository
+ */
+void ScComponentManagerCommandInit::SubmitSpecifications(
+    ScMemoryContext * context,
+    componentUtils::ThreadPool & downloadPool,
+    ScAddr const & repositoryAddr,
+    ScAddrVector const & specificationsAddrs)
+{
+  if (specificationsAddrs.empty())
+    return;
+
+  DownloadRequest indexRequest;
+  bool const hasIndex = downloaderHandler->GetRepositoryIndexRequest(context, repositoryAddr, indexRequest);
+
+  // Addresses are read from the knowledge base here, workers only download
+  std::vector<SpecificationDownload> specifications;
+  for (ScAddr const & componentSpecificationAddr : specificationsAddrs)
+  {
+    SpecificationDownload specification;
+    specification.specificationAddr = componentSpecificationAddr;
+    specification.systemIdtf = context->HelperGetSystemIdtf(componentSpecificationAddr);
+
+    std::vector<DownloadRequest> const requests =
+        downloaderHandler->GetDownloadRequests(context, componentSpecificationAddr);
+    for (DownloadRequest const & request : requests)
+    {
+      std::string const urlKey = componentUtils::UrlUtils::NormalizeUrl(request.url) +
+                                 SpecificationConstants::DIRECTORY_DELIMETR + request.pathPostfix;
+      if (m_downloadedUrls.insert(urlKey).second)
+        specification.requests.push_back(request);
+      else
+        SC_LOG_DEBUG("ScComponentManagerCommandInit: \"" + request.url + "\" is already downloaded");
+    }
+
+    if (specification.requests.empty() && (!requests.empty() || !hasIndex))
+    {
+      if (!requests.empty())
+        ++m_savedDownloadsCount;
+      continue;
+    }
+
+    ++m_pendingSpecificationsCount;
+    specifications.push_back(specification);
+  }
+
+  if (!hasIndex)
+  {
+    for (SpecificationDownload const & specification : specifications)
+    {
+      downloadPool.Submit([this, specification]() {
+        FetchSpecification(specification);
+      });
+    }
     return;
+  }
 
-  ScAddr const repository = availableRepositories.back();
+  downloadPool.Submit([this, &downloadPool, indexRequest, specifications]() {
+    FetchRepositoryIndex(downloadPool, indexRequest, specifications);
+  });
+}
 
-  ScAddrVector currentRepositoriesAddrs;
+/**
+ * @brief Fetch stage of init pipeline for repository with index.
+ * Index is downloaded once and split into specifications files.
+ * Specifications that aren't found in index are submitted
+ * to be downloaded separately.
+ * @param downloadPool pool of workers that download specifications
+ * @param indexRequest download request of repository index
+ * @param specifications specifications of repository
+ */
+void ScComponentManagerCommandInit::FetchRepositoryIndex(
+    componentUtils::ThreadPool & downloadPool,
+    DownloadRequest const & indexRequest,
+    std::vector<SpecificationDownload> const & specifications)
+{
+  componentUtils::RepositoryIndex index;
+  std::string const indexFilePath =
+      indexRequest.downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + indexRequest.pathPostfix;
   try
   {
-    currentRepositoriesAddrs = GetSpecificationsAddrs(
-        context, repository, keynodes::ScComponentManagerKeynodes::rrel_repositories_specifications);
+    std::remove(indexFilePath.c_str());
+    downloaderHandler->Download(indexRequest);
+    if (index.Load(indexFilePath))
+      SC_LOG_DEBUG(
+          "ScComponentManagerCommandInit: Index of \"" + indexRequest.url + "\" contains " +
+          std::to_string(index.GetSize()) + " specifications");
   }
   catch (utils::ScException const & exception)
   {
-    SC_LOG_DEBUG("Problem getting repositories specifications");
-    SC_LOG_DEBUG(exception.Message());
+    SC_LOG_ERROR(exception.Message());
+  }
+
+  for (SpecificationDownload const & specification : specifications)
+  {
+    componentUtils::RepositoryIndexEntry entry;
+    if (!index.Find(specification.systemIdtf, entry))
+    {
+      downloadPool.Submit([this, specification]() {
+        FetchSpecification(specification);
+      });
+      continue;
+    }
+
+    FetchedSpecification fetchedSpecification;
+    fetchedSpecification.specificationAddr = specification.specificationAddr;
+    fetchedSpecification.systemIdtf = specification.systemIdtf;
+
+    std::string const specificationPath =
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + specification.systemIdtf;
+    std::string const specificationFilePath =
+        specificationPath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::SPECIFICATION_FILENAME;
+
+    try
+    {
+      componentUtils::ManifestEntry manifestEntry;
+      if (m_isIncremental && m_manifest.Find(specification.systemIdtf, manifestEntry) &&
+          manifestEntry.url == indexRequest.url && manifestEntry.hash == entry.hash &&
+          componentUtils::Hasher::GetFileHash(specificationFilePath) == entry.hash)
+      {
+        SC_LOG_DEBUG("ScComponentManagerCommandInit: \"" + specification.systemIdtf + "\" is up to date");
+      }
+      else if (sc_fs_mkdirs(specificationPath.c_str()))
+      {
+        // File can be hardlink to download cache, so it is replaced instead of rewriting
+        std::remove(specificationFilePath.c_str());
+        std::ofstream specificationFile(specificationFilePath, std::ios::binary | std::ios::trunc);
+        specificationFile << entry.content;
+        specificationFile.close();
+
+        fetchedSpecification.isChanged = specificationFile.good();
+        if (fetchedSpecification.isChanged)
+          m_manifest.Update(specification.systemIdtf, {indexRequest.url, entry.hash, entry.hash});
+      }
+    }
+    catch (std::exception const & exception)
+    {
+      SC_LOG_ERROR(exception.what());
+      fetchedSpecification.isChanged = false;
+    }
+
+    // Each specification is pushed, so apply stage knows when all specifications are processed
+    m_fetchedSpecifications->Push(std::move(fetchedSpecification));
   }
+}
 
-  availableRepositories.insert(
-      availableRepositories.begin(), currentRepositoriesAddrs.begin(), currentRepositoriesAddrs.end());
+/**
+ * @brief Fetch stage of init pipeline. Downloads specification
+ * and passes it to parse stage, even if download is failed.
+ * @param specification specification and its download requests
+ */
+void ScComponentManagerCommandInit::FetchSpecification(SpecificationDownload const & specification)
+{
+  FetchedSpecification fetchedSpecification;
+  fetchedSpecification.specificationAddr = specification.specificationAddr;
+  fetchedSpecification.systemIdtf = specification.systemIdtf;
 
-  ScAddrVector currentComponentsSpecificationsAddrs;
   try
   {
-    currentComponentsSpecificationsAddrs = GetSpecificationsAddrs(
-        context, repository, keynodes::ScComponentManagerKeynodes::rrel_components_specifications);
+    fetchedSpecification.isChanged = DownloadSpecification(specification.requests);
   }
-  catch (utils::ScException const & exception)
+  catch (std::exception const & exception)
   {
-    SC_LOG_DEBUG("Problem getting component specifications");
-    SC_LOG_DEBUG(exception.Message());
+    SC_LOG_ERROR(exception.what());
+  }
+
+  m_fetchedSpecifications->Push(std::move(fetchedSpecification));
+}
+
+/**
+ * @brief Parse stage of init pipeline. Reads .scs files of changed
+ * specifications and parses them into elements, so incorrect files
+ * don't reach the knowledge base and apply stage doesn't parse texts again.
+ * Unchanged texts are taken from cache of parsed files.
+ * Works until fetch queue is closed.
+ */
+void ScComponentManagerCommandInit::ParseSpecifications()
+{
+  FetchedSpecification fetchedSpecification;
+  while (m_fetchedSpecifications->Pop(fetchedSpecification))
+  {
+    ParsedSpecification parsedSpecification;
+    parsedSpecification.specificationAddr = fetchedSpecification.specificationAddr;
+
+    std::string const specificationPath =
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + fetchedSpecification.systemIdtf;
+    try
+    {
+      if (fetchedSpecification.isChanged)
+      {
+        for (std::string const & filePath : componentUtils::LoadUtils::GetScsFilesInDir(specificationPath))
+        {
+          std::string error;
+          componentUtils::ScsTriples triples;
+          if (componentUtils::LoadUtils::ParseScsFile(filePath, m_scsCache, triples, error))
+            parsedSpecification.scsFiles.push_back(std::move(triples));
+          else
+            SC_LOG_WARNING("ScComponentManagerCommandInit: \"" + filePath + "\" is skipped. " + error);
+        }
+      }
+    }
+    catch (std::exception const & exception)
+    {
+      SC_LOG_ERROR(
+          "ScComponentManagerCommandInit: \"" + specificationPath + "\" isn't parsed. " +
+          std::string(exception.what()));
+      parsedSpecification.scsFiles.clear();
+    }
+
+    // Failed specification is pushed too, otherwise apply stage waits for it forever
+    m_parsedSpecifications->Push(std::move(parsedSpecification));
   }
+}
+
+/**
+ * @brief Apply stage of init pipeline. Loads parsed specification
+ * into the knowledge base and adds its dependencies to repositories queue.
+ * @param context current sc-memory context
+ * @param specification parsed specification
+ * @param repositoriesQueue queue of repositories addrs
+ */
+void ScComponentManagerCommandInit::ApplySpecification(
+    ScMemoryContext * context,
+    ParsedSpecification const & specification,
+    std::queue<ScAddr> & repositoriesQueue)
+{
+  componentUtils::ScsBatchLoader::Apply(context, specification.scsFiles);
+
+  ScAddrVector const componentDependencies =
+      componentUtils::SearchUtils::GetComponentDependencies(context, specification.specificationAddr);
+  for (ScAddr const & componentDependency : componentDependencies)
+    VisitNode(specification.specificationAddr, componentDependency, repositoriesQueue);
+}
+
+/**
+ * @brief Download specification if it is changed since the previous init
+ * and remember its state in manifest. Specification is always downloaded
+ * if init isn't incremental. Alternative addresses of specification are raced,
+ * and address that won is saved in manifest. It doesn't use sc-memory,
+ * so it is called by download workers.
+ * @param requests download requests of alternative addresses of specification
+ * @return true if specification is downloaded, false if it is up to date
+ */
+bool ScComponentManagerCommandInit::DownloadSpecification(std::vector<DownloadRequest> const & requests)
+{
+  if (requests.empty())
+    return false;
+
+  DownloadRequest const & request = requests.front();
+  std::string const specificationFilePath =
+      request.downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + request.pathPostfix;
 
-  for (ScAddr const & componentSpecificationAddr : currentComponentsSpecificationsAddrs)
+  std::vector<DownloadRequest> alternativeRequests = requests;
+  componentUtils::ManifestEntry entry;
+  if (m_isIncremental && m_manifest.Find(request.systemIdtf, entry))
   {
-    downloaderHandler->Download(context, componentSpecificationAddr);
-    std::string const specificationPath = m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR +
-                                          context->HelperGetSystemIdtf(componentSpecificationAddr);
-    componentUtils::LoadUtils::LoadScsFilesInDir(context, specificationPath);
+    // Only address that was downloaded last time is checked, so dead mirrors aren't requested
+    for (DownloadRequest & alternativeRequest : alternativeRequests)
+    {
+      if (alternativeRequest.url != entry.url)
+        continue;
 
-    ScAddrVector componentDependencies =
-        componentUtils::SearchUtils::GetComponentDependencies(context, componentSpecificationAddr);
-    availableRepositories.insert(
-        availableRepositories.end(), componentDependencies.begin(), componentDependencies.end());
+      alternativeRequest.revision = downloaderHandler->GetRevision(alternativeRequest);
+      if (!alternativeRequest.revision.empty() && entry.revision == alternativeRequest.revision &&
+          entry.hash == componentUtils::Hasher::GetFileHash(specificationFilePath))
+      {
+        SC_LOG_DEBUG("ScComponentManagerCommandInit: \"" + request.systemIdtf + "\" is up to date");
+        return false;
+      }
+      break;
+    }
   }
 
-  availableRepositories.pop_back();
-  ProcessRepositories(context, availableRepositories);
+  DownloadResult const result = downloaderHandler->DownloadAlternatives(alternativeRequests);
+  if (!result.isSuccess)
+    return false;
+
+  m_manifest.Update(
+      request.systemIdtf,
+      {result.url, result.revision, componentUtils::Hasher::GetFileHash(specificationFilePath)});
+
+  return true;
+}
+
+/**
+ * @brief Remember edge of repositories graph and add
+ * its target to the queue if it wasn't visited before.
+ * @param sourceAddr sc-addr of node that refers to targetAddr
+ * @param targetAddr sc-addr of referred node
+ * @param repositoriesQueue queue of repositories addrs
+ */
+void ScComponentManagerCommandInit::VisitNode(
+    ScAddr const & sourceAddr,
+    ScAddr const & targetAddr,
+    std::queue<ScAddr> & repositoriesQueue)
+{
+  m_graph[sourceAddr].push_back(targetAddr);
+  if (m_visitedNodes.insert(targetAddr).second)
+    repositoriesQueue.push(targetAddr);
+}
+
+/**
+ * @brief Find cycles in traversed repositories graph.
+ * @param context current sc-memory context
+ * @return Vector of found cycles descriptions
+ */
+ExecutionResult ScComponentManagerCommandInit::FindCycles(ScMemoryContext * context) const
+{
+  enum class NodeState
+  {
+    InProgress,
+    Finished
+  };
+
+  ExecutionResult cycles;
+  std::map<ScAddr, NodeState, ScAddrLessFunc> states;
+
+  for (auto const & graphIt : m_graph)
+  {
+    if (states.count(graphIt.first))
+      continue;
+
+    // Iterative depth-first search, path contains nodes and indexes of their next edges
+    std::vector<std::pair<ScAddr, size_t>> path = {{graphIt.first, 0}};
+    states[graphIt.first] = NodeState::InProgress;
+    while (!path.empty())
+    {
+      ScAddr const currentAddr = path.back().first;
+      auto const & edgesIt = m_graph.find(currentAddr);
+      if (edgesIt == m_graph.cend() || path.back().second >= edgesIt->second.size())
+      {
+        states[currentAddr] = NodeState::Finished;
+        path.pop_back();
+        continue;
+      }
+
+      ScAddr const nextAddr = edgesIt->second.at(path.back().second++);
+      auto const & stateIt = states.find(nextAddr);
+      if (stateIt == states.cend())
+      {
+        states[nextAddr] = NodeState::InProgress;
+        path.emplace_back(nextAddr, 0);
+      }
+      else if (stateIt->second == NodeState::InProgress)
+      {
+        auto pathIt = path.cbegin();
+        while (pathIt->first != nextAddr)
+          ++pathIt;
+
+        std::string cycle;
+        for (; pathIt != path.cend(); ++pathIt)
+          cycle += GetNodeName(context, pathIt->first) + " -> ";
+        cycles.push_back("Cycle detected: " + cycle + GetNodeName(context, nextAddr));
+      }
+    }
+  }
+
+  return cycles;
+}
+
+/**
+ * @brief Get name of node to display it
+ * @param context current sc-memory context
+ * @param nodeAddr sc-addr of node
+ * @return System identifier of node or its hash if node has no identifier
+ */
+std::string ScComponentManagerCommandInit::GetNodeName(ScMemoryContext * context, ScAddr const & nodeAddr)
+{
+  std::string nodeName = context->HelperGetSystemIdtf(nodeAddr);
+  if (nodeName.empty())
+    nodeName = std::to_string(nodeAddr.Hash());
+  return nodeName;
 }
 
 /**
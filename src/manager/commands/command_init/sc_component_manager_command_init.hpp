@@ -6,33 +6,133 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+
 #include <sc-agents-common/utils/IteratorUtils.hpp>
 #include <sc-agents-common/utils/CommonUtils.hpp>
 
 #include "src/manager/commands/sc_component_manager_command.hpp"
 #include "src/manager/downloader/downloader.hpp"
 #include "src/manager/downloader/downloader_handler.hpp"
+#include "src/manager/sc_component_manager_settings.hpp"
+#include "src/manager/utils/blocking_queue.hpp"
+#include "src/manager/utils/scs_cache.hpp"
+#include "src/manager/utils/scs_triples.hpp"
+#include "src/manager/utils/specifications_manifest.hpp"
+#include "src/manager/utils/thread_pool.hpp"
+
+/**
+ * @brief Specification that is passed to fetch stage of init pipeline.
+ */
+struct SpecificationDownload
+{
+  ScAddr specificationAddr;
+  std::string systemIdtf;
+  std::vector<DownloadRequest> requests;
+};
+
+/**
+ * @brief Specification that passed fetch stage of init pipeline.
+ */
+struct FetchedSpecification
+{
+  ScAddr specificationAddr;
+  std::string systemIdtf;
+  bool isChanged = false;
+};
+
+/**
+ * @brief Specification that passed parse stage of init pipeline.
+ * It contains parsed elements of all its .scs files.
+ */
+struct ParsedSpecification
+{
+  ScAddr specificationAddr;
+  std::vector<componentUtils::ScsTriples> scsFiles;
+};
 
 class ScComponentManagerCommandInit : public ScComponentManagerCommand
 {
 public:
-  explicit ScComponentManagerCommandInit(std::string specificationsPath)
+  explicit ScComponentManagerCommandInit(
+      std::string specificationsPath,
+      std::shared_ptr<DownloaderHandler> downloaderHandler,
+      ScComponentManagerSettings const & settings = {})
     : m_specificationsPath(std::move(specificationsPath))
+    , downloaderHandler(std::move(downloaderHandler))
+    , m_downloadThreadsCount(settings.downloadThreadsCount)
+    , m_parseThreadsCount(settings.parseThreadsCount)
+    , m_manifest(
+          m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR +
+          SpecificationConstants::MANIFEST_FILENAME)
+    , m_scsCache(
+          m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::CACHE_DIRECTORY +
+          SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::SCS_CACHE_DIRECTORY)
   {
   }
 
   ExecutionResult Execute(ScMemoryContext * context, CommandParameters const & commandParameters) override;
 
-  void ProcessRepositories(ScMemoryContext * context, ScAddrVector & availableRepositories);
+  void ProcessRepositories(
+      ScMemoryContext * context,
+      componentUtils::ThreadPool & downloadPool,
+      std::queue<ScAddr> & repositoriesQueue);
 
   static ScAddrVector GetSpecificationsAddrs(
       ScMemoryContext * context,
       ScAddr const & repositoryAddr,
       ScAddr const & rrelAddr);
 
-  static void DownloadSpecification(ScMemoryContext * context, ScAddr const & componentSpecificationAddr);
+  bool DownloadSpecification(std::vector<DownloadRequest> const & requests);
 
 protected:
+  static size_t constexpr kPipelineQueueCapacity = 16;
+
   std::string m_specificationsPath;
-  std::unique_ptr<DownloaderHandler> downloaderHandler = std::make_unique<DownloaderHandler>(m_specificationsPath);
+  std::shared_ptr<DownloaderHandler> downloaderHandler;
+  size_t m_downloadThreadsCount;
+  size_t m_parseThreadsCount;
+  std::string const PARAMETER_INCREMENTAL = "incremental";
+
+  componentUtils::SpecificationsManifest m_manifest;
+  componentUtils::ScsCache m_scsCache;
+  bool m_isIncremental = false;
+
+  std::set<ScAddr, ScAddrLessFunc> m_visitedNodes;
+  std::set<std::string> m_downloadedUrls;
+  std::map<ScAddr, ScAddrVector, ScAddrLessFunc> m_graph;
+  size_t m_savedDownloadsCount = 0;
+
+  std::unique_ptr<componentUtils::BlockingQueue<FetchedSpecification>> m_fetchedSpecifications;
+  std::unique_ptr<componentUtils::BlockingQueue<ParsedSpecification>> m_parsedSpecifications;
+  size_t m_pendingSpecificationsCount = 0;
+
+  void SubmitSpecifications(
+      ScMemoryContext * context,
+      componentUtils::ThreadPool & downloadPool,
+      ScAddr const & repositoryAddr,
+      ScAddrVector const & specificationsAddrs);
+
+  void FetchRepositoryIndex(
+      componentUtils::ThreadPool & downloadPool,
+      DownloadRequest const & indexRequest,
+      std::vector<SpecificationDownload> const & specifications);
+
+  void FetchSpecification(SpecificationDownload const & specification);
+
+  void ParseSpecifications();
+
+  void ApplySpecification(
+      ScMemoryContext * context,
+      ParsedSpecification const & specification,
+      std::queue<ScAddr> & repositoriesQueue);
+
+  void VisitNode(ScAddr const & sourceAddr, ScAddr const & targetAddr, std::queue<ScAddr> & repositoriesQueue);
+
+  ExecutionResult FindCycles(ScMemoryContext * context) const;
+
+  static std::string GetNodeName(ScMemoryContext * context, ScAddr const & nodeAddr);
 };
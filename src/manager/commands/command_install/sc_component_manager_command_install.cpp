@@ -5,15 +5,69 @@
  */
 
 #include "sc_component_manager_command_install.hpp"
-#include <sc-memory/utils/sc_exec.hpp>
+
+#include <algorithm>
+#include <ctime>
+
 #include <sc-builder/src/scs_loader.hpp>
+#include "src/manager/utils/blocking_queue.hpp"
+#include "src/manager/utils/content_digest.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
 #include "src/manager/utils/sc_component_utils.hpp"
+#include "src/manager/utils/thread_pool.hpp"
 
 #include "src/manager/commands/command_init/constants/command_init_constants.hpp"
 
-ScComponentManagerCommandInstall::ScComponentManagerCommandInstall(std::string specificationsPath)
+namespace
+{
+std::string GetDownloadActionName(DownloadAction action)
+{
+  switch (action)
+  {
+  case DownloadAction::Copy:
+    return "copy";
+  case DownloadAction::Cached:
+    return "cached";
+  case DownloadAction::Update:
+    return "update";
+  default:
+    return "fetch";
+  }
+}
+}  // namespace
+
+ScComponentManagerCommandInstall::ScComponentManagerCommandInstall(
+    std::string specificationsPath,
+    std::shared_ptr<DownloaderHandler> downloaderHandler,
+    std::shared_ptr<componentUtils::ProcessRunner> processRunner,
+    ScComponentManagerSettings const & settings)
   : m_specificationsPath(std::move(specificationsPath))
+  , m_scsCachePath(
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::CACHE_DIRECTORY +
+        SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::SCS_CACHE_DIRECTORY)
+  , downloaderHandler(std::move(downloaderHandler))
+  , m_processRunner(std::move(processRunner))
+  , m_installTimeout(settings.installTimeout)
+  , m_installCpuTimeout(settings.installCpuTimeout)
+  , m_installThreadsCount(std::max<size_t>(settings.installThreadsCount, 1))
+  , m_manifest(
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR +
+        SpecificationConstants::COMPONENTS_MANIFEST_FILENAME)
+  , m_loadIndex(
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::CACHE_DIRECTORY +
+        SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::LOAD_INDEX_FILENAME)
+  , m_history(
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR +
+        SpecificationConstants::INSTALL_HISTORY_FILENAME)
+  , m_registry(
+        m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR +
+        SpecificationConstants::COMPONENTS_REGISTRY_FILENAME)
 {
+  m_manifest.Load();
+  m_loadIndex.Load();
+  m_history.Load();
+  m_registry.Load();
 }
 
 /**
@@ -49,25 +103,48 @@ ScAddrVector ScComponentManagerCommandInstall::GetAvailableComponents(
 }
 
 /**
- * @brief Installation of component
- * @param context current sc-memory context
- * @param componentAddr component sc-addr
+ * @brief Run install scripts of component one by one
+ * in component directory until one of them fails.
+ * @param installation installation of component, failure of script is added to its failures
+ * @return true if all scripts are successful
  */
-void ScComponentManagerCommandInstall::InstallComponent(ScMemoryContext * context, ScAddr const & componentAddr)
+bool ScComponentManagerCommandInstall::InstallComponent(ComponentInstallation & installation)
 {
-  std::vector<std::string> scripts = componentUtils::InstallUtils::GetInstallScripts(context, componentAddr);
-  for (auto script : scripts)
+  std::string const path =
+      m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + installation.systemIdtf;
+  for (auto script : installation.scripts)
   {
-    std::string componentDirName =
-        componentUtils::InstallUtils::GetComponentDirName(context, componentAddr, m_specificationsPath);
-    std::string nodeSystIdtf = context->HelperGetSystemIdtf(componentAddr);
-    std::string path = m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + nodeSystIdtf;
     script = "." + script;
     sc_fs_mkdirs(path.c_str());
-    ScExec exec{{"cd", path, "&&", script}};
+
+    componentUtils::ProcessOptions options;
+    options.arguments = {script};
+    options.workingDirectory = path;
+    options.timeout = m_installTimeout;
+    options.cpuTimeout = m_installCpuTimeout;
+
+    SC_LOG_INFO("ScComponentManager: Run \"" + script + "\" of \"" + installation.systemIdtf + "\"");
+    componentUtils::ProcessResult const result = m_processRunner->Run(options);
+    if (!result.IsSuccess())
+    {
+      std::string const message =
+          "Component \"" + installation.systemIdtf + "\": script \"" + script + "\" failed, " + result.ToString();
+      SC_LOG_ERROR(message);
+      installation.failures.push_back(message);
+      return false;
+    }
   }
+
+  return true;
 }
 
+/**
+ * @brief Install components with their dependencies. With `--plan` flag components aren't installed,
+ * and plan of installation is returned instead.
+ * @param context current sc-memory context
+ * @param commandParameters identifiers of components
+ * @return Failures of downloads and install scripts, return empty vector if all components are installed
+ */
 ExecutionResult ScComponentManagerCommandInstall::Execute(
     ScMemoryContext * context,
     CommandParameters const & commandParameters)
@@ -75,29 +152,303 @@ ExecutionResult ScComponentManagerCommandInstall::Execute(
   ExecutionResult executionResult;
   std::vector<std::string> componentsToInstall;
 
-  try
+  auto const & componentsIt = commandParameters.find(PARAMETER_NAME);
+  if (componentsIt != commandParameters.cend())
+    componentsToInstall = componentsIt->second;
+  else
   {
-    componentsToInstall = commandParameters.at(PARAMETER_NAME);
+    // All marked components are resolved as one graph, so shared dependencies are installed once
+    componentsToInstall = componentUtils::SearchUtils::GetNeedToInstallComponents(context);
+    SC_LOG_INFO(
+        "No identifier provided, installing all " + std::to_string(componentsToInstall.size()) +
+        " components from concept_need_to_install");
+    if (componentsToInstall.empty())
+      return executionResult;
   }
-  catch (std::exception const & exception)
+
+  ScAddrVector availableComponents = GetAvailableComponents(context, componentsToInstall);
+
+  componentUtils::DependencyGraph graph;
+  std::unordered_set<std::string> failedComponents;
+  if (!ResolveDependencies(context, availableComponents, graph, failedComponents, executionResult))
+    return executionResult;
+
+  std::vector<std::string> availableComponentsIdtfs;
+  for (ScAddr const & componentAddr : availableComponents)
+    availableComponentsIdtfs.push_back(context->HelperGetSystemIdtf(componentAddr));
+
+  std::vector<std::string> installOrder;
+  std::vector<std::string> cycle;
+  if (!graph.GetInstallOrder(availableComponentsIdtfs, installOrder, cycle))
   {
-    // TODO: Implement install all components method
-    SC_LOG_INFO("No identifier provided, installing all to install components");
+    std::string message = "Components aren't installed, dependencies have cycle: ";
+    for (size_t i = 0; i < cycle.size(); ++i)
+      message += (i == 0 ? "\"" : " -> \"") + cycle[i] + "\"";
+    SC_LOG_ERROR(message);
+    executionResult.push_back(message);
+    return executionResult;
+  }
 
+  if (commandParameters.count(PARAMETER_PLAN))
+  {
+    ExecutionResult const plan = PlanComponents(context, graph, installOrder, failedComponents);
+    executionResult.insert(executionResult.cend(), plan.cbegin(), plan.cend());
     return executionResult;
   }
 
-  ScAddrVector availableComponents = GetAvailableComponents(context, componentsToInstall);
+  InstallComponents(context, graph, installOrder, failedComponents, executionResult);
 
-  for (ScAddr componentAddr : availableComponents)
+  SC_LOG_INFO("ScComponentManagerCommandInstall: downloads: " + downloaderHandler->GetStatistics().ToString());
+
+  return executionResult;
+}
+
+/**
+ * @brief Describe work of installation without downloading and running anything. Action of each component
+ * is found by its downloaded revision and downloads cache, and its costs are taken from previous installations.
+ * @param context current sc-memory context
+ * @param graph graph of components
+ * @param installOrder components in topological order
+ * @param failedComponents components that can't be installed
+ * @return Lines of plan, one line per component and summary
+ */
+ExecutionResult ScComponentManagerCommandInstall::PlanComponents(
+    ScMemoryContext * context,
+    componentUtils::DependencyGraph const & graph,
+    std::vector<std::string> const & installOrder,
+    std::unordered_set<std::string> const & failedComponents)
+{
+  ExecutionResult plan;
+  std::unordered_set<std::string> skippedComponents;
+  std::unordered_map<std::string, std::chrono::milliseconds> durations;
+  std::chrono::milliseconds totalDuration{0};
+  size_t unknownDurationsCount = 0;
+  for (std::string const & componentIdtf : installOrder)
   {
-    InstallDependencies(context, componentAddr);
-    DownloadComponent(context, componentAddr);
-    InstallComponent(context, componentAddr);
-    // TODO: need to process installation method from component specification in kb
+    std::string const prefix = "Plan: \"" + componentIdtf + "\": ";
+    if (failedComponents.count(componentIdtf))
+    {
+      skippedComponents.insert(componentIdtf);
+      plan.push_back(prefix + "skip, it can't be installed");
+      continue;
+    }
+
+    std::vector<std::string> const & dependencies = graph.GetDependencies(componentIdtf);
+    auto const & skippedDependencyIt =
+        std::find_if(dependencies.cbegin(), dependencies.cend(), [&skippedComponents](std::string const & dependency) {
+          return skippedComponents.count(dependency) != 0;
+        });
+    if (skippedDependencyIt != dependencies.cend())
+    {
+      skippedComponents.insert(componentIdtf);
+      plan.push_back(prefix + "skip, dependency \"" + *skippedDependencyIt + "\" is skipped");
+      continue;
+    }
+
+    ComponentInstallation installation;
+    installation.systemIdtf = componentIdtf;
+    PrepareComponent(context, context->HelperFindBySystemIdtf(componentIdtf), installation);
+    if (installation.requests.empty())
+    {
+      skippedComponents.insert(componentIdtf);
+      plan.push_back(prefix + "skip, it has no address");
+      continue;
+    }
+
+    // Downloaded component is updated from its source, other components are downloaded from the first address
+    componentUtils::ManifestEntry manifestEntry;
+    DownloadRequest request = installation.requests.front();
+    if (m_manifest.Find(componentIdtf, manifestEntry))
+    {
+      auto const & requestIt = std::find_if(
+          installation.requests.cbegin(),
+          installation.requests.cend(),
+          [&manifestEntry](DownloadRequest const & candidate) {
+            return componentUtils::UrlUtils::NormalizeUrl(candidate.url) ==
+                   componentUtils::UrlUtils::NormalizeUrl(manifestEntry.url);
+          });
+      if (requestIt != installation.requests.cend())
+        request = *requestIt;
+      else
+        manifestEntry = {};
+    }
+
+    DownloadAction const action = downloaderHandler->GetDownloadAction(request, manifestEntry.revision);
+    std::string line = prefix + GetDownloadActionName(action) + " " + request.url;
+    if (!installation.scripts.empty())
+      line += ", run " + std::to_string(installation.scripts.size()) + " scripts";
+
+    componentUtils::RegistryEntry registryEntry;
+    if (m_registry.Find(componentIdtf, registryEntry))
+      line += ", installed revision " + (registryEntry.revision.empty() ? "unknown" : registryEntry.revision);
+
+    componentUtils::InstallHistoryEntry historyEntry;
+    if (m_history.Find(componentIdtf, historyEntry))
+    {
+      if (action == DownloadAction::Fetch && historyEntry.downloadedBytes != 0)
+        line += ", download about " + std::to_string(historyEntry.downloadedBytes) + " bytes";
+      line += ", previous install took " + std::to_string(historyEntry.GetDuration().count()) + " ms";
+      durations[componentIdtf] = historyEntry.GetDuration();
+      totalDuration += historyEntry.GetDuration();
+    }
+    else
+    {
+      line += ", no previous install";
+      ++unknownDurationsCount;
+    }
+    plan.push_back(line);
   }
 
-  return executionResult;
+  std::vector<std::string> criticalPath;
+  std::chrono::milliseconds const criticalDuration = graph.GetCriticalPath(installOrder, durations, criticalPath);
+  std::string criticalPathString;
+  for (std::string const & componentIdtf : criticalPath)
+    criticalPathString += (criticalPathString.empty() ? "\"" : " -> \"") + componentIdtf + "\"";
+
+  size_t const componentsCount = installOrder.size() - skippedComponents.size();
+  size_t const workersCount = std::max<size_t>(std::min(m_installThreadsCount, componentsCount), 1);
+  // Workers can't make installation faster than its critical path or total work divided between them
+  std::chrono::milliseconds const expectedDuration = std::max(
+      criticalDuration,
+      std::chrono::milliseconds(totalDuration.count() / static_cast<std::chrono::milliseconds::rep>(workersCount)));
+  plan.push_back(
+      "Plan: " + std::to_string(componentsCount) + " components to install, " +
+      std::to_string(skippedComponents.size()) + " skipped, " + std::to_string(unknownDurationsCount) +
+      " without previous install");
+  plan.push_back(
+      "Plan: total work " + std::to_string(totalDuration.count()) + " ms, critical path " +
+      std::to_string(criticalDuration.count()) + " ms" + (criticalPathString.empty() ? "" : ": " + criticalPathString) +
+      ", expected duration with " + std::to_string(workersCount) + " install workers " +
+      std::to_string(expectedDuration.count()) + " ms");
+
+  return plan;
+}
+
+/**
+ * @brief Install components as soon as all their dependencies are installed. Downloads and install scripts
+ * of independent components are run by pool of `install_threads` workers, and files of installed components
+ * are loaded into sc-memory by the calling thread one by one.
+ * @param context current sc-memory context
+ * @param graph graph of components
+ * @param installOrder components in topological order
+ * @param failedComponents components that can't be installed, failed components are added to it
+ * @param executionResult result of command
+ */
+void ScComponentManagerCommandInstall::InstallComponents(
+    ScMemoryContext * context,
+    componentUtils::DependencyGraph const & graph,
+    std::vector<std::string> const & installOrder,
+    std::unordered_set<std::string> & failedComponents,
+    ExecutionResult & executionResult)
+{
+  // All installations are made before workers start, so workers don't see changes of map
+  std::unordered_map<std::string, ComponentInstallation> installations;
+  std::unordered_map<std::string, size_t> notInstalledDependenciesCounts;
+  std::unordered_map<std::string, std::vector<std::string>> dependents;
+  for (std::string const & componentIdtf : installOrder)
+  {
+    installations[componentIdtf].systemIdtf = componentIdtf;
+    std::vector<std::string> const & dependencies = graph.GetDependencies(componentIdtf);
+    notInstalledDependenciesCounts[componentIdtf] = dependencies.size();
+    for (std::string const & dependency : dependencies)
+      dependents[dependency].push_back(componentIdtf);
+  }
+
+  componentUtils::ThreadPool installPool(std::min(m_installThreadsCount, std::max<size_t>(installOrder.size(), 1)));
+  componentUtils::BlockingQueue<std::string> finishedComponents(installOrder.size());
+  size_t runningCount = 0;
+
+  auto const & startInstallation = [&](std::string const & componentIdtf) {
+    ComponentInstallation & installation = installations.at(componentIdtf);
+    PrepareComponent(context, context->HelperFindBySystemIdtf(componentIdtf), installation);
+    ++runningCount;
+    installPool.Submit([this, &installation, &finishedComponents]() {
+      RunInstallation(installation);
+      finishedComponents.Push(installation.systemIdtf);
+    });
+  };
+
+  // Installed component can make its dependents ready, and failed component fails all its dependents
+  auto const & finishInstallation = [&](std::string const & componentIdtf, bool isInstalled) {
+    std::vector<std::pair<std::string, bool>> finished = {{componentIdtf, isInstalled}};
+    while (!finished.empty())
+    {
+      std::pair<std::string, bool> const component = finished.back();
+      finished.pop_back();
+      for (std::string const & dependent : dependents[component.first])
+      {
+        if (failedComponents.count(dependent))
+          continue;
+
+        if (!component.second)
+        {
+          std::string const message =
+              "Component \"" + dependent + "\": dependency \"" + component.first + "\" is not installed";
+          SC_LOG_ERROR(message);
+          executionResult.push_back(message);
+          failedComponents.insert(dependent);
+          finished.emplace_back(dependent, false);
+        }
+        else if (--notInstalledDependenciesCounts[dependent] == 0)
+          startInstallation(dependent);
+      }
+    }
+  };
+
+  for (std::string const & componentIdtf : installOrder)
+  {
+    if (failedComponents.count(componentIdtf))
+      finishInstallation(componentIdtf, false);
+  }
+  for (std::string const & componentIdtf : installOrder)
+  {
+    if (!failedComponents.count(componentIdtf) && notInstalledDependenciesCounts[componentIdtf] == 0)
+      startInstallation(componentIdtf);
+  }
+
+  std::string componentIdtf;
+  while (runningCount > 0 && finishedComponents.Pop(componentIdtf))
+  {
+    --runningCount;
+    ComponentInstallation & installation = installations.at(componentIdtf);
+    executionResult.insert(executionResult.cend(), installation.failures.cbegin(), installation.failures.cend());
+
+    if (installation.isDownloaded && !LoadComponentFiles(context, installation.scsFilesPaths))
+      SC_LOG_WARNING("Not all files of \"" + componentIdtf + "\" are loaded");
+
+    if (installation.isInstalled && !installation.isUpToDate)
+    {
+      m_registry.Update(
+          componentIdtf,
+          {installation.url,
+           installation.revision,
+           static_cast<int64_t>(std::time(nullptr)),
+           installation.hash,
+           GetSpecificationHash(installation),
+           installation.files});
+
+      componentUtils::InstallHistoryEntry historyEntry;
+      m_history.Find(componentIdtf, historyEntry);
+      if (installation.downloadedBytes != 0)
+        historyEntry.downloadedBytes = installation.downloadedBytes;
+      historyEntry.downloadDuration = installation.downloadDuration;
+      historyEntry.scriptsDuration = installation.scriptsDuration;
+      m_history.Update(componentIdtf, historyEntry);
+    }
+    else if (!installation.isInstalled)
+    {
+      // Partially installed component isn't up to date
+      m_registry.Remove(componentIdtf);
+      failedComponents.insert(componentIdtf);
+    }
+    finishInstallation(componentIdtf, installation.isInstalled);
+  }
+  m_history.Save();
+  m_registry.Save();
+
+  SC_LOG_DEBUG(
+      "ScComponentManagerCommandInstall: " + std::to_string(installOrder.size()) + " components are processed by " +
+      std::to_string(installPool.GetThreadsCount()) + " install workers");
 }
 
 /**
@@ -137,52 +488,334 @@ void ScComponentManagerCommandInstall::ValidateComponent(ScMemoryContext * conte
 }
 
 /**
- * Tries to install component dependencies.
- * @return Returns {DependencyIdtf1, DependencyIdtf2, ...}
- * if installation successfull, otherwise
- * returns empty vector.
+ * Build graph of components with all their direct and indirect dependencies.
+ * Each component is visited once, so shared dependencies and cycles don't repeat visits.
+ * @param context current sc-memory context
+ * @param componentsAddrs requested components
+ * @param graph graph of components by system identifiers
+ * @param invalidComponents dependencies that can't be installed, failures are added to execution result
+ * @param executionResult result of command
+ * @return false if dependency has no system identifier, so graph can't be built
  */
-ExecutionResult ScComponentManagerCommandInstall::InstallDependencies(
+bool ScComponentManagerCommandInstall::ResolveDependencies(
     ScMemoryContext * context,
-    ScAddr const & componentAddr)
+    ScAddrVector const & componentsAddrs,
+    componentUtils::DependencyGraph & graph,
+    std::unordered_set<std::string> & invalidComponents,
+    ExecutionResult & executionResult)
 {
-  ExecutionResult result;
-  // Get component dependencies and install them recursively
-  ScAddrVector const & componentDependencies =
-      componentUtils::SearchUtils::GetComponentDependencies(context, componentAddr);
-  for (ScAddr const & componentDependency : componentDependencies)
+  ScAddrVector componentsToVisit = componentsAddrs;
+  while (!componentsToVisit.empty())
   {
-    std::string dependencyIdtf = context->HelperGetSystemIdtf(componentDependency);
-    SC_LOG_INFO("ScComponentManager: Install dependency \"" + dependencyIdtf + "\"");
-    CommandParameters dependencyParameters = {{PARAMETER_NAME, {dependencyIdtf}}};
-    ExecutionResult dependencyResult = Execute(context, dependencyParameters);
+    ScAddr const componentAddr = componentsToVisit.back();
+    componentsToVisit.pop_back();
+    std::string const componentIdtf = context->HelperGetSystemIdtf(componentAddr);
+    if (graph.Contains(componentIdtf))
+      continue;
 
-    // Return empty if you couldn't install one from all dependencies why?
-    if (dependencyResult.empty())
+    std::vector<std::string> dependenciesIdtfs;
+    for (ScAddr const & dependencyAddr : componentUtils::SearchUtils::GetComponentDependencies(context, componentAddr))
     {
-      SC_LOG_ERROR("Dependency \"" + dependencyIdtf + "\" is not installed");
-      // return dependencyResult;
-    }
-    else
-    {
-      result.insert(result.cbegin(), dependencyResult.cbegin(), dependencyResult.cend());
+      std::string const dependencyIdtf = context->HelperGetSystemIdtf(dependencyAddr);
+      if (dependencyIdtf.empty())
+      {
+        std::string const message = "Component \"" + componentIdtf + "\": dependency has no system identifier";
+        SC_LOG_ERROR(message);
+        executionResult.push_back(message);
+        return false;
+      }
+
+      dependenciesIdtfs.push_back(dependencyIdtf);
+      if (graph.Contains(dependencyIdtf) || invalidComponents.count(dependencyIdtf))
+        continue;
+
+      try
+      {
+        ValidateComponent(context, dependencyAddr);
+        componentsToVisit.push_back(dependencyAddr);
+      }
+      catch (utils::ScException const & exception)
+      {
+        std::string const message = "Dependency \"" + dependencyIdtf + "\" can't be installed";
+        SC_LOG_ERROR(message);
+        SC_LOG_DEBUG(exception.Message());
+        executionResult.push_back(message);
+        invalidComponents.insert(dependencyIdtf);
+      }
     }
+
+    graph.AddComponent(componentIdtf, dependenciesIdtfs);
+  }
+
+  return true;
+}
+
+/**
+ * Download and install component, it doesn't use sc-memory, so it is run by install workers.
+ * Component that is up to date isn't downloaded and its scripts aren't run again.
+ * @param installation installation of component
+ */
+void ScComponentManagerCommandInstall::RunInstallation(ComponentInstallation & installation)
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::string const componentPath =
+      m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + installation.systemIdtf;
+  if (IsUpToDate(installation))
+  {
+    SC_LOG_INFO("ScComponentManager: \"" + installation.systemIdtf + "\" is up to date, it isn't installed again");
+    installation.isUpToDate = true;
+    installation.isDownloaded = true;
+    installation.isInstalled = true;
+    // Files are checked by load index, so they are loaded again only if sc-memory doesn't contain them
+    installation.scsFilesPaths = componentUtils::LoadUtils::GetScsFilesInDir(
+        componentPath, installation.includePatterns, installation.excludePatterns);
+    return;
   }
 
-  return result;
+  Clock::time_point const downloadStartTime = Clock::now();
+  DownloadComponent(installation);
+  Clock::time_point const scriptsStartTime = Clock::now();
+  installation.downloadDuration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(scriptsStartTime - downloadStartTime);
+  if (!installation.isDownloaded)
+    return;
+
+  installation.hash = installation.checksum.empty() ? componentUtils::ContentDigest::GetPathHash(componentPath)
+                                                     : installation.checksum;
+  installation.isInstalled = InstallComponent(installation);
+  installation.scriptsDuration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - scriptsStartTime);
+
+  for (std::string const & filePath : componentUtils::FileUtils::GetFilesInDirectory(componentPath, ""))
+    installation.files.push_back(filePath.substr(componentPath.size() + 1));
+}
+
+/**
+ * Check if installed component is the same as its source. Source with checksum is checked without network,
+ * local and mirrored sources are checked by checksum of their content, other sources are checked by their
+ * current revision. If current revision can't be resolved, installed component is trusted. Changed install
+ * scripts or files patterns and removed files of component make it outdated.
+ * @param installation installation of component
+ * @return true if component doesn't need to be installed again
+ */
+bool ScComponentManagerCommandInstall::IsUpToDate(ComponentInstallation const & installation)
+{
+  componentUtils::RegistryEntry entry;
+  if (!m_registry.Find(installation.systemIdtf, entry) ||
+      entry.specificationHash != GetSpecificationHash(installation))
+    return false;
+
+  auto const & requestIt = std::find_if(
+      installation.requests.cbegin(),
+      installation.requests.cend(),
+      [&entry](DownloadRequest const & request) {
+        return componentUtils::UrlUtils::NormalizeUrl(request.url) == componentUtils::UrlUtils::NormalizeUrl(entry.url);
+      });
+  if (requestIt == installation.requests.cend())
+    return false;
+
+  std::string const checksum =
+      requestIt->checksum.empty() ? downloaderHandler->GetLocalChecksum(*requestIt) : requestIt->checksum;
+  if (!checksum.empty())
+  {
+    if (checksum != entry.hash)
+      return false;
+  }
+  else
+  {
+    std::string const revision = requestIt->revision.empty() ? downloaderHandler->GetRevision(*requestIt)
+                                                               : requestIt->revision;
+    if (revision.empty())
+      SC_LOG_WARNING(
+          "ScComponentManager: revision of \"" + installation.systemIdtf +
+          "\" can't be resolved, installed revision " + (entry.revision.empty() ? "unknown" : entry.revision) +
+          " is trusted");
+    else if (revision != entry.revision)
+      return false;
+  }
+
+  std::string const componentPath =
+      m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + installation.systemIdtf;
+  return std::all_of(entry.files.cbegin(), entry.files.cend(), [&componentPath](std::string const & filePath) {
+    struct stat fileStat;
+    return stat((componentPath + SpecificationConstants::DIRECTORY_DELIMETR + filePath).c_str(), &fileStat) == 0;
+  });
 }
 
 /**
- * Tries to download component from Github
+ * Get hash of parts of component specification that change result of installation
+ * @param installation installation of component
+ * @return Hash of install scripts and files patterns
  */
-void ScComponentManagerCommandInstall::DownloadComponent(ScMemoryContext * context, ScAddr const & componentAddr)
+std::string ScComponentManagerCommandInstall::GetSpecificationHash(ComponentInstallation const & installation)
 {
-  downloaderHandler->Download(context, componentAddr);
+  std::string specification;
+  for (auto const * values : {&installation.scripts, &installation.includePatterns, &installation.excludePatterns})
+  {
+    for (std::string const & value : *values)
+      specification += value + '\n';
+    specification += '\0';
+  }
+
+  return componentUtils::Hasher::GetStringHash(specification);
+}
+
+/**
+ * Find in sc-memory everything that is needed to install component, so it is installed without sc-memory context
+ * @param context current sc-memory context
+ * @param componentAddr component sc-addr
+ * @param installation installation of component
+ */
+void ScComponentManagerCommandInstall::PrepareComponent(
+    ScMemoryContext * context,
+    ScAddr const & componentAddr,
+    ComponentInstallation & installation)
+{
+  installation.requests = downloaderHandler->GetDownloadRequests(context, componentAddr);
+  installation.includePatterns = componentUtils::SearchUtils::GetComponentFilesPatterns(
+      context, componentAddr, keynodes::ScComponentManagerKeynodes::nrel_included_files);
+  installation.excludePatterns = componentUtils::SearchUtils::GetComponentFilesPatterns(
+      context, componentAddr, keynodes::ScComponentManagerKeynodes::nrel_excluded_files);
+  installation.scripts = componentUtils::InstallUtils::GetInstallScripts(context, componentAddr);
+}
+
+/**
+ * Tries to download component. Already downloaded component is updated
+ * by files changed since its recorded revision, and only changed .scs files are loaded.
+ * Files are filtered by include and exclude patterns of component specification.
+ * It doesn't use sc-memory, so components are downloaded in parallel.
+ * @param installation installation of component, .scs files to load are added to it
+ */
+void ScComponentManagerCommandInstall::DownloadComponent(ComponentInstallation & installation)
+{
+  std::string const & systemIdtf = installation.systemIdtf;
+  SC_LOG_INFO("ScComponentManager: Install \"" + systemIdtf + "\"");
+
+  componentUtils::ManifestEntry entry;
+  if (m_manifest.Find(systemIdtf, entry) && UpdateComponent(installation, entry))
+  {
+    installation.url = entry.url;
+    installation.isDownloaded = true;
+    return;
+  }
+
+  DownloadResult const result = downloaderHandler->DownloadAlternatives(installation.requests);
+  if (!result.isSuccess)
+  {
+    std::string const message = "Component \"" + systemIdtf + "\": download failed";
+    SC_LOG_ERROR(message);
+    installation.failures.push_back(message);
+    return;
+  }
+
+  m_manifest.Update(systemIdtf, {result.url, result.revision, ""});
+  m_manifest.Save();
+  installation.url = result.url;
+  installation.revision = result.revision;
+  installation.downloadedBytes = result.bytesCount;
+  auto const & requestIt = std::find_if(
+      installation.requests.cbegin(),
+      installation.requests.cend(),
+      [&result](DownloadRequest const & request) {
+        return request.url == result.url;
+      });
+  if (requestIt != installation.requests.cend())
+    installation.checksum = requestIt->checksum;
+
+  std::string const componentPath = m_specificationsPath + SpecificationConstants::DIRECTORY_DELIMETR + systemIdtf;
+  installation.scsFilesPaths = componentUtils::LoadUtils::GetScsFilesInDir(
+      componentPath, installation.includePatterns, installation.excludePatterns);
+  installation.isDownloaded = true;
+}
+
+/**
+ * Update downloaded component in place by changes of its source
+ * @param installation installation of component, changed .scs files are added to it
+ * @param entry source and revision of downloaded component
+ * @return false if component can't be updated, then it has to be downloaded again
+ */
+bool ScComponentManagerCommandInstall::UpdateComponent(
+    ComponentInstallation & installation,
+    componentUtils::ManifestEntry const & entry)
+{
+  std::string const & SCS_EXTENSION = SpecificationConstants::SCS_EXTENSION;
+  std::vector<DownloadRequest> const & requests = installation.requests;
+
+  auto const & requestIt = std::find_if(
+      requests.cbegin(),
+      requests.cend(),
+      [&entry](DownloadRequest const & request) {
+        return componentUtils::UrlUtils::NormalizeUrl(request.url) == componentUtils::UrlUtils::NormalizeUrl(entry.url);
+      });
+  if (requestIt == requests.cend())
+    return false;
+
+  std::string currentRevision;
+  std::vector<std::string> changedPaths;
+  if (!downloaderHandler->DownloadChanges(*requestIt, entry.revision, currentRevision, changedPaths))
+    return false;
+
+  if (currentRevision != entry.revision)
+  {
+    m_manifest.Update(requestIt->systemIdtf, {entry.url, currentRevision, entry.hash});
+    m_manifest.Save();
+  }
+  installation.revision = currentRevision;
+  installation.checksum = requestIt->checksum;
+
+  for (std::string const & changedPath : changedPaths)
+  {
+    if (changedPath.size() > SCS_EXTENSION.size() &&
+        changedPath.compare(changedPath.size() - SCS_EXTENSION.size(), SCS_EXTENSION.size(), SCS_EXTENSION) == 0 &&
+        componentUtils::LoadUtils::IsScsFileIncluded(
+            changedPath, installation.includePatterns, installation.excludePatterns))
+      installation.scsFilesPaths.push_back(
+          requestIt->downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + changedPath);
+  }
+
+  SC_LOG_INFO(
+      "ScComponentManager: \"" + requestIt->systemIdtf + "\" is updated to " + currentRevision + ", " +
+      std::to_string(changedPaths.size()) + " files are changed");
+  return true;
+}
+
+/**
+ * Load .scs files that are changed since they were loaded last time. File is unchanged
+ * if it isn't changed by index and its content is still marked as loaded in sc-memory.
+ * Index is updated only if all changed files are loaded, so failed files are loaded again next time.
+ * @param context current sc-memory context
+ * @param filesPaths paths of .scs files
+ * @return true if all changed files are loaded
+ */
+bool ScComponentManagerCommandInstall::LoadComponentFiles(
+    ScMemoryContext * context,
+    std::vector<std::string> const & filesPaths)
+{
+  std::vector<std::string> changedFilesPaths;
+  std::vector<componentUtils::LoadIndexEntry> changedEntries;
+  for (std::string const & filePath : filesPaths)
+  {
+    componentUtils::LoadIndexEntry fileEntry;
+    if (!m_loadIndex.IsChanged(filePath, fileEntry) &&
+        componentUtils::LoadUtils::IsScsTextLoaded(context, fileEntry.hash))
+      continue;
+
+    changedFilesPaths.push_back(filePath);
+    changedEntries.push_back(fileEntry);
+  }
+
+  SC_LOG_DEBUG(
+      "ScComponentManager: " + std::to_string(filesPaths.size() - changedFilesPaths.size()) + " of " +
+      std::to_string(filesPaths.size()) + " files are unchanged and skipped");
+  if (changedFilesPaths.empty())
+    return true;
+
+  if (!componentUtils::LoadUtils::LoadScsFiles(context, changedFilesPaths, m_scsCachePath))
+    return false;
 
-  //  std::string componentDirName =
-  //      componentUtils::InstallUtils::GetComponentDirName(context, componentAddr, m_specificationsPath);
-  //  if (!componentUtils::LoadUtils::LoadScsFilesInDir(context, componentDirName))
-  //  {
-  //    SC_LOG_WARNING("Not all files are loaded from" + componentDirName);
-  //  }
+  for (size_t i = 0; i < changedFilesPaths.size(); ++i)
+    m_loadIndex.Update(changedFilesPaths[i], changedEntries[i]);
+  m_loadIndex.Save();
+  return true;
 }
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <dirent.h>
 #include <sys/stat.h>
 
@@ -13,33 +17,121 @@
 #include "src/manager/commands/keynodes/ScComponentManagerKeynodes.hpp"
 #include "src/manager/downloader/downloader.hpp"
 #include "src/manager/downloader/downloader_handler.hpp"
+#include "src/manager/sc_component_manager_settings.hpp"
+#include "src/manager/utils/components_registry.hpp"
+#include "src/manager/utils/dependency_graph.hpp"
+#include "src/manager/utils/install_history.hpp"
+#include "src/manager/utils/load_index.hpp"
+#include "src/manager/utils/process_runner.hpp"
+#include "src/manager/utils/specifications_manifest.hpp"
 
 extern "C"
 {
 #include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
 }
 
+/**
+ * @brief Everything that is needed to download and install component without sc-memory
+ * context, and the result of its installation.
+ */
+struct ComponentInstallation
+{
+  std::string systemIdtf;
+  std::vector<DownloadRequest> requests;
+  std::vector<std::string> includePatterns;
+  std::vector<std::string> excludePatterns;
+  std::vector<std::string> scripts;
+  // Paths of downloaded .scs files that should be loaded into sc-memory
+  std::vector<std::string> scsFilesPaths;
+  ExecutionResult failures;
+  // Source and content of downloaded component
+  std::string url;
+  std::string revision;
+  std::string checksum;
+  std::string hash;
+  // Paths of component files after installation relative to component directory
+  std::vector<std::string> files;
+  bool isDownloaded = false;
+  bool isInstalled = false;
+  // Component is installed already, so it isn't downloaded and its scripts aren't run
+  bool isUpToDate = false;
+  // Size of full download, it is zero if component is updated by changes or taken from cache
+  uint64_t downloadedBytes = 0;
+  std::chrono::milliseconds downloadDuration{0};
+  std::chrono::milliseconds scriptsDuration{0};
+};
+
 class ScComponentManagerCommandInstall : public ScComponentManagerCommand
 {
   std::string const PARAMETER_NAME = "idtf";
+  std::string const PARAMETER_PLAN = "plan";
 
 public:
-  explicit ScComponentManagerCommandInstall(std::string specificationsPath);
+  ScComponentManagerCommandInstall(
+      std::string specificationsPath,
+      std::shared_ptr<DownloaderHandler> downloaderHandler,
+      std::shared_ptr<componentUtils::ProcessRunner> processRunner,
+      ScComponentManagerSettings const & settings = {});
 
   ExecutionResult Execute(ScMemoryContext * context, CommandParameters const & commandParameters) override;
 
 protected:
   static void ValidateComponent(ScMemoryContext * context, ScAddr const & componentAddr);
 
-  void DownloadComponent(ScMemoryContext * context, ScAddr const & componentAddr);
+  void PrepareComponent(ScMemoryContext * context, ScAddr const & componentAddr, ComponentInstallation & installation);
+
+  void RunInstallation(ComponentInstallation & installation);
+
+  bool IsUpToDate(ComponentInstallation const & installation);
 
-  ExecutionResult InstallDependencies(ScMemoryContext * context, ScAddr const & componentAddr);
+  static std::string GetSpecificationHash(ComponentInstallation const & installation);
+
+  virtual void DownloadComponent(ComponentInstallation & installation);
+
+  bool UpdateComponent(ComponentInstallation & installation, componentUtils::ManifestEntry const & entry);
+
+  bool LoadComponentFiles(ScMemoryContext * context, std::vector<std::string> const & filesPaths);
+
+  bool ResolveDependencies(
+      ScMemoryContext * context,
+      ScAddrVector const & componentsAddrs,
+      componentUtils::DependencyGraph & graph,
+      std::unordered_set<std::string> & invalidComponents,
+      ExecutionResult & executionResult);
 
   ScAddrVector GetAvailableComponents(ScMemoryContext * context, std::vector<std::string> componentsToInstall);
 
-  void InstallComponent(ScMemoryContext * context, ScAddr const & componentAddr);
+  bool InstallComponent(ComponentInstallation & installation);
+
+  ExecutionResult PlanComponents(
+      ScMemoryContext * context,
+      componentUtils::DependencyGraph const & graph,
+      std::vector<std::string> const & installOrder,
+      std::unordered_set<std::string> const & failedComponents);
+
+  void InstallComponents(
+      ScMemoryContext * context,
+      componentUtils::DependencyGraph const & graph,
+      std::vector<std::string> const & installOrder,
+      std::unordered_set<std::string> & failedComponents,
+      ExecutionResult & executionResult);
 
   std::string m_specificationsPath;
+  // Directory of parsed .scs files cache
+  std::string m_scsCachePath;
 
-  std::unique_ptr<DownloaderHandler> downloaderHandler = std::make_unique<DownloaderHandler>(m_specificationsPath);
+  std::shared_ptr<DownloaderHandler> downloaderHandler;
+  std::shared_ptr<componentUtils::ProcessRunner> m_processRunner;
+  std::chrono::seconds m_installTimeout;
+  std::chrono::seconds m_installCpuTimeout;
+  // Count of workers that download and install independent components at the same time
+  size_t m_installThreadsCount;
+  // Sources and revisions of downloaded components
+  componentUtils::SpecificationsManifest m_manifest;
+  // States of loaded .scs files, so unchanged files aren't loaded again
+  componentUtils::LoadIndex m_loadIndex;
+  // Costs of previous installations, they are used to estimate plan of installation
+  componentUtils::InstallHistory m_history;
+  // Installed state of components, components that are up to date aren't installed again
+  componentUtils::ComponentsRegistry m_registry;
 };
@@ -17,6 +17,9 @@ ScAddr ScComponentManagerKeynodes::concept_complex_address;
 ScAddr ScComponentManagerKeynodes::concept_single_address;
 ScAddr ScComponentManagerKeynodes::concept_github_url;
 ScAddr ScComponentManagerKeynodes::concept_google_drive_url;
+ScAddr ScComponentManagerKeynodes::concept_http_url;
+ScAddr ScComponentManagerKeynodes::concept_loaded_scs_text;
+ScAddr ScComponentManagerKeynodes::concept_need_to_install;
 ScAddr ScComponentManagerKeynodes::rrel_repositories_specifications;
 ScAddr ScComponentManagerKeynodes::rrel_components_specifications;
 ScAddr ScComponentManagerKeynodes::nrel_authors;
@@ -26,5 +29,8 @@ ScAddr ScComponentManagerKeynodes::nrel_component_dependencies;
 ScAddr ScComponentManagerKeynodes::nrel_installation_method;
 ScAddr ScComponentManagerKeynodes::nrel_alternative_addresses;
 ScAddr ScComponentManagerKeynodes::nrel_repository_address;
+ScAddr ScComponentManagerKeynodes::nrel_checksum;
 ScAddr ScComponentManagerKeynodes::nrel_installation_script;
+ScAddr ScComponentManagerKeynodes::nrel_included_files;
+ScAddr ScComponentManagerKeynodes::nrel_excluded_files;
 }  // namespace keynodes
@@ -40,6 +40,15 @@ public:
   SC_PROPERTY(Keynode("concept_google_drive_url"), ForceCreate(ScType::NodeConstClass))
   static ScAddr concept_google_drive_url;
 
+  SC_PROPERTY(Keynode("concept_http_url"), ForceCreate(ScType::NodeConstClass))
+  static ScAddr concept_http_url;
+
+  SC_PROPERTY(Keynode("concept_loaded_scs_text"), ForceCreate(ScType::NodeConstClass))
+  static ScAddr concept_loaded_scs_text;
+
+  SC_PROPERTY(Keynode("concept_need_to_install"), ForceCreate(ScType::NodeConstClass))
+  static ScAddr concept_need_to_install;
+
   SC_PROPERTY(Keynode("rrel_repositories_specifications"), ForceCreate(ScType::NodeConstRole))
   static ScAddr rrel_repositories_specifications;
 
@@ -67,8 +76,17 @@ public:
   SC_PROPERTY(Keynode("nrel_repository_address"), ForceCreate(ScType::NodeConstNoRole))
   static ScAddr nrel_repository_address;
 
+  SC_PROPERTY(Keynode("nrel_checksum"), ForceCreate(ScType::NodeConstNoRole))
+  static ScAddr nrel_checksum;
+
   SC_PROPERTY(Keynode("nrel_installation_script"), ForceCreate(ScType::NodeConstNoRole))
   static ScAddr nrel_installation_script;
+
+  SC_PROPERTY(Keynode("nrel_included_files"), ForceCreate(ScType::NodeConstNoRole))
+  static ScAddr nrel_included_files;
+
+  SC_PROPERTY(Keynode("nrel_excluded_files"), ForceCreate(ScType::NodeConstNoRole))
+  static ScAddr nrel_excluded_files;
 };
 
 }  // namespace keynodes
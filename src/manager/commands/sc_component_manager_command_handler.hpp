@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 
 #include "sc_component_manager_handler.hpp"
@@ -13,12 +14,19 @@
 #include "src/manager/commands/command_init/sc_component_manager_command_init.hpp"
 #include "src/manager/commands/command_search/sc_component_manager_command_search.hpp"
 #include "src/manager/commands/command_install/sc_component_manager_command_install.hpp"
+#include "src/manager/sc_component_manager_settings.hpp"
+#include "src/manager/utils/process_runner.hpp"
 
 class ScComponentManagerCommandHandler : public ScComponentManagerHandler
 {
 public:
-  explicit ScComponentManagerCommandHandler(std::string specificationsPath)
+  explicit ScComponentManagerCommandHandler(
+      std::string specificationsPath,
+      ScComponentManagerSettings const & settings = {})
     : m_specificationsPath(std::move(specificationsPath))
+    , m_settings(settings)
+    , m_processRunner(std::make_shared<componentUtils::ProcessRunner>())
+    , m_downloaderHandler(std::make_shared<DownloaderHandler>(m_specificationsPath, m_settings, m_processRunner))
   {
     m_context = new ScMemoryContext("sc-component-manager-command-handler");
   }
@@ -59,9 +67,15 @@ protected:
 
   CommandParameters m_commandParameters;
   std::string m_specificationsPath;
+  ScComponentManagerSettings m_settings;
+  // Processes of all commands are watched by one runner
+  std::shared_ptr<componentUtils::ProcessRunner> m_processRunner;
+  // Init and install share downloads cache
+  std::shared_ptr<DownloaderHandler> m_downloaderHandler;
 
   std::map<std::string, ScComponentManagerCommand *> m_actions = {
-      {"init", new ScComponentManagerCommandInit(m_specificationsPath)},
+      {"init", new ScComponentManagerCommandInit(m_specificationsPath, m_downloaderHandler, m_settings)},
       {"search", new ScComponentManagerCommandSearch()},
-      {"install", new ScComponentManagerCommandInstall(m_specificationsPath)}};
+      {"install",
+       new ScComponentManagerCommandInstall(m_specificationsPath, m_downloaderHandler, m_processRunner, m_settings)}};
 };
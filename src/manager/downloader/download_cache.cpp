@@ -0,0 +1,127 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "download_cache.hpp"
+
+#include <cstdio>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
+#include "src/manager/utils/sc_component_utils.hpp"
+
+DownloadCache::DownloadCache(std::string cachePath)
+  : m_objectsPath(cachePath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::OBJECTS_DIRECTORY)
+  , m_stagingPath(cachePath + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::STAGING_DIRECTORY)
+{
+}
+
+/**
+ * @brief Get key of source payload
+ * @param url url of source, it is normalized, so equal urls have equal keys
+ * @param revision revision of source
+ * @param pathPostfix requested path in source
+ * @return Key of payload in cache
+ */
+std::string DownloadCache::GetKey(
+    std::string const & url,
+    std::string const & revision,
+    std::string const & pathPostfix)
+{
+  return componentUtils::Hasher::GetStringHash(
+      componentUtils::UrlUtils::NormalizeUrl(url) + "\n" + revision + "\n" + pathPostfix);
+}
+
+/**
+ * @brief Get key of payload with known checksum. Payload is found by its
+ * content, so it is shared by all addresses and revisions with the same files.
+ * @param checksum checksum of payload files
+ * @param pathPostfix path of payload in source, it is a part of key
+ * because checksum of single file doesn't contain its path
+ * @return Key of payload
+ */
+std::string DownloadCache::GetContentKey(std::string const & checksum, std::string const & pathPostfix)
+{
+  return componentUtils::Hasher::GetStringHash("sha256:" + checksum + "\n" + pathPostfix);
+}
+
+/**
+ * @brief Replace target directory by files of cached payload.
+ * Previous files of target directory are removed, see FileUtils::ReplaceDirectory.
+ * @param key key of payload
+ * @param targetPath directory where payload files are placed
+ * @param isHardlinkAllowed if true, then files can be hardlinks to cache,
+ * so they mustn't be changed in place
+ * @return false if payload isn't cached or it can't be placed into target directory
+ */
+bool DownloadCache::Materialize(std::string const & key, std::string const & targetPath, bool isHardlinkAllowed)
+    const
+{
+  std::string const objectPath = GetObjectPath(key);
+  if (!componentUtils::FileUtils::IsDirectory(objectPath))
+    return false;
+
+  if (!componentUtils::FileUtils::ReplaceDirectory(objectPath, targetPath, isHardlinkAllowed))
+  {
+    SC_LOG_WARNING("DownloadCache: Can't copy files from cache to \"" + targetPath + "\"");
+    return false;
+  }
+
+  return true;
+}
+
+bool DownloadCache::Contains(std::string const & key) const
+{
+  return componentUtils::FileUtils::IsDirectory(GetObjectPath(key));
+}
+
+/**
+ * @brief Create directory to download new payload in. It is placed
+ * on the same file system as cache, so payload is moved into cache without copying.
+ * @return Path to created directory, return empty string if it isn't created
+ */
+std::string DownloadCache::MakeStagingDirectory() const
+{
+  return componentUtils::FileUtils::MakeTemporaryDirectory(m_stagingPath);
+}
+
+/**
+ * @brief Move downloaded payload into cache. If the same payload
+ * is already stored by another thread, then downloaded one is removed.
+ * @param key key of payload
+ * @param stagingPath directory with downloaded payload
+ * @return true if payload with key is in cache
+ */
+bool DownloadCache::Store(std::string const & key, std::string const & stagingPath)
+{
+  std::string const objectPath = GetObjectPath(key);
+  std::string const objectParentPath =
+      objectPath.substr(0, objectPath.rfind(SpecificationConstants::DIRECTORY_DELIMETR));
+  if (!sc_fs_mkdirs(objectParentPath.c_str()))
+  {
+    componentUtils::FileUtils::RemoveDirectory(stagingPath);
+    return false;
+  }
+
+  if (std::rename(stagingPath.c_str(), objectPath.c_str()) != 0)
+    componentUtils::FileUtils::RemoveDirectory(stagingPath);
+
+  return componentUtils::FileUtils::IsDirectory(objectPath);
+}
+
+std::string DownloadCache::GetObjectPath(std::string const & key) const
+{
+  // Objects are split by the first byte of key, so directories don't become too big
+  return m_objectsPath + SpecificationConstants::DIRECTORY_DELIMETR + key.substr(0, 2) +
+         SpecificationConstants::DIRECTORY_DELIMETR + key;
+}
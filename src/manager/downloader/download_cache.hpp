@@ -0,0 +1,39 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Content addressed storage of downloaded sources. Payload of each
+ * source is stored once by key of its url and revision, and then
+ * specifications and components directories are made from it
+ * without downloading.
+ */
+class DownloadCache
+{
+public:
+  explicit DownloadCache(std::string cachePath);
+
+  static std::string GetKey(std::string const & url, std::string const & revision, std::string const & pathPostfix);
+
+  static std::string GetContentKey(std::string const & checksum, std::string const & pathPostfix);
+
+  bool Materialize(std::string const & key, std::string const & targetPath, bool isHardlinkAllowed) const;
+
+  bool Contains(std::string const & key) const;
+
+  std::string MakeStagingDirectory() const;
+
+  bool Store(std::string const & key, std::string const & stagingPath);
+
+protected:
+  std::string m_objectsPath;
+  std::string m_stagingPath;
+
+  std::string GetObjectPath(std::string const & key) const;
+};
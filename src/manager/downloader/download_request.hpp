@@ -0,0 +1,69 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "sc-memory/sc_addr.hpp"
+
+/**
+ * @brief Resolved download of one address. It doesn't refer
+ * to sc-memory, so it can be processed in any thread.
+ */
+struct DownloadRequest
+{
+  std::string systemIdtf;
+  std::string downloadPath;
+  std::string url;
+  std::string pathPostfix;
+  ScAddr urlClassAddr;
+  // Revision that is downloaded, it is requested from source if it is empty
+  std::string revision;
+  // Expected checksum of downloaded files, it isn't checked if it is empty
+  std::string checksum;
+};
+
+/**
+ * @brief Status of one download attempt.
+ */
+enum class DownloadStatus
+{
+  Downloaded,
+  // Attempt is failed, e.g. connection is broken, and it can be retried
+  Failed,
+  // Attempt fails again if it is retried, e.g. source isn't found or its checksum differs
+  FailedPermanently
+};
+
+/**
+ * @brief Result of one attempt to download request.
+ */
+struct DownloadAttempt
+{
+  DownloadStatus status = DownloadStatus::Failed;
+  // Revision that is downloaded, it is empty if source has no revisions
+  std::string revision;
+  // Size of transferred files, files that are taken from cache or copied from local source aren't counted
+  size_t bytesCount = 0;
+};
+
+/**
+ * @brief Result of scheduled download request.
+ */
+struct DownloadResult
+{
+  bool isSuccess = false;
+  // Address that is downloaded, it is one of alternative addresses if they are raced
+  std::string url;
+  // Revision that is downloaded, it is empty if source has no revisions
+  std::string revision;
+  size_t attemptsCount = 0;
+  // Time from submitting request to its completion, including time in queue and retries delays
+  std::chrono::milliseconds latency{0};
+  size_t bytesCount = 0;
+};
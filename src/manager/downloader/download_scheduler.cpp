@@ -0,0 +1,312 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "download_scheduler.hpp"
+
+#include <algorithm>
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/sc_component_utils.hpp"
+
+DownloadScheduler::DownloadScheduler(
+    DownloadFunction download,
+    ScComponentManagerSettings const & settings,
+    PlaceFunction place)
+  : m_download(std::move(download))
+  , m_place(std::move(place))
+  , m_hostConnectionsLimit(std::max<size_t>(settings.hostConnectionsLimit, 1))
+  , m_retriesCount(settings.downloadRetriesCount)
+  , m_retryDelay(settings.downloadRetryDelay)
+  , m_random(std::random_device()())
+{
+  size_t const threadsCount = std::max<size_t>(settings.downloadThreadsCount, 1);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(&DownloadScheduler::Work, this);
+}
+
+/**
+ * @brief Stop workers. Requests that aren't started yet are completed as failed.
+ */
+DownloadScheduler::~DownloadScheduler()
+{
+  std::list<Task> canceledTasks;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopped = true;
+    canceledTasks.swap(m_tasks);
+  }
+  m_tasksChanged.notify_all();
+
+  for (std::thread & worker : m_workers)
+    worker.join();
+
+  // Downloads that are started are completed by workers, so only canceled ones are in flight
+  for (Task & task : canceledTasks)
+  {
+    DownloadResult result;
+    result.url = task.request.url;
+    result.attemptsCount = task.attemptsCount;
+    for (Waiter & waiter : m_inFlightDownloads[task.key].waiters)
+      waiter.promise->set_value(result);
+    task.result->set_value(result);
+  }
+  m_inFlightDownloads.clear();
+}
+
+/**
+ * @brief Add download request to the queue. If the same source is queued
+ * or downloaded now, then it isn't downloaded again: result of that request is returned
+ * if target is the same, otherwise source is placed into target when it is downloaded.
+ * @param request download request
+ * @return Future result of download, it is ready when request
+ * is downloaded or all its attempts are failed
+ */
+std::shared_future<DownloadResult> DownloadScheduler::Submit(DownloadRequest const & request)
+{
+  Task task;
+  task.request = request;
+  task.key = GetRequestKey(request);
+  task.host = componentUtils::UrlUtils::GetHost(request.url);
+  task.submitTime = Clock::now();
+  task.readyTime = task.submitTime;
+  task.result = std::make_shared<std::promise<DownloadResult>>();
+  std::shared_future<DownloadResult> result = task.result->get_future().share();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isStopped)
+    {
+      task.result->set_value(DownloadResult());
+      return result;
+    }
+
+    auto const & inFlightDownload = m_inFlightDownloads.find(task.key);
+    if (inFlightDownload != m_inFlightDownloads.cend())
+    {
+      ++m_statistics.collapsedRequestsCount;
+      SC_LOG_DEBUG("DownloadScheduler: \"" + request.url + "\" is already in flight, its download is shared");
+      InFlightDownload & download = inFlightDownload->second;
+      if (download.downloadPath == request.downloadPath)
+        return download.result;
+
+      for (Waiter const & waiter : download.waiters)
+      {
+        if (waiter.request.downloadPath == request.downloadPath)
+          return waiter.result;
+      }
+
+      download.waiters.push_back({request, task.result, result});
+      return result;
+    }
+
+    InFlightDownload & download = m_inFlightDownloads[task.key];
+    download.downloadPath = request.downloadPath;
+    download.result = result;
+    m_tasks.push_back(std::move(task));
+  }
+  m_tasksChanged.notify_one();
+
+  return result;
+}
+
+DownloadStatistics DownloadScheduler::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_statistics;
+}
+
+void DownloadScheduler::Work()
+{
+  while (true)
+  {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!TakeTask(lock, task))
+        return;
+    }
+
+    DownloadAttempt attempt;
+    try
+    {
+      attempt = m_download(task.request);
+    }
+    catch (utils::ScException const & exception)
+    {
+      SC_LOG_ERROR(exception.Message());
+    }
+    catch (std::exception const & exception)
+    {
+      SC_LOG_ERROR(exception.what());
+    }
+    ++task.attemptsCount;
+    bool const isSuccess = attempt.status == DownloadStatus::Downloaded;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    --m_hostConnections[task.host];
+    m_statistics.bytesCount += attempt.bytesCount;
+
+    // Source that isn't found or doesn't match its checksum isn't downloaded by the next attempts
+    if (attempt.status == DownloadStatus::Failed && task.attemptsCount <= m_retriesCount && !m_isStopped)
+    {
+      std::chrono::milliseconds const delay = GetRetryDelay(task.attemptsCount);
+      SC_LOG_WARNING(
+          "DownloadScheduler: Can't download \"" + task.request.url + "\", retry in " +
+          std::to_string(delay.count()) + " ms");
+      task.readyTime = Clock::now() + delay;
+      ++m_statistics.retriesCount;
+      m_tasks.push_back(std::move(task));
+      lock.unlock();
+      m_tasksChanged.notify_all();
+      continue;
+    }
+
+    DownloadResult result;
+    result.isSuccess = isSuccess;
+    result.url = task.request.url;
+    result.revision = attempt.revision;
+    result.attemptsCount = task.attemptsCount;
+    result.latency = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - task.submitTime);
+    result.bytesCount = attempt.bytesCount;
+
+    // The next same request downloads source again, because source can be changed since this request
+    std::list<Waiter> waiters;
+    waiters.swap(m_inFlightDownloads[task.key].waiters);
+    m_inFlightDownloads.erase(task.key);
+    ++m_statistics.requestsCount;
+    m_statistics.failedRequestsCount += isSuccess ? 0 : 1;
+    m_statistics.totalLatency += result.latency;
+    m_statistics.maxLatency = std::max(m_statistics.maxLatency, result.latency);
+    lock.unlock();
+    m_tasksChanged.notify_all();
+
+    if (isSuccess)
+      SC_LOG_DEBUG(
+          "DownloadScheduler: \"" + task.request.url + "\" is downloaded in " + std::to_string(result.latency.count()) +
+          " ms, " + std::to_string(result.bytesCount) + " bytes, attempts: " + std::to_string(result.attemptsCount));
+    else
+      SC_LOG_ERROR(
+          "DownloadScheduler: Can't download \"" + task.request.url + "\", attempts: " +
+          std::to_string(result.attemptsCount));
+
+    CompleteWaiters(task, waiters, result);
+    task.result->set_value(result);
+  }
+}
+
+/**
+ * @brief Place downloaded source into targets of requests that waited for it
+ * @param task downloaded task
+ * @param waiters requests of the same source with other targets
+ * @param result result of downloaded task
+ */
+void DownloadScheduler::CompleteWaiters(Task const & task, std::list<Waiter> & waiters, DownloadResult const & result)
+{
+  for (Waiter & waiter : waiters)
+  {
+    // Source is transferred once, so its bytes are counted only for downloaded request
+    DownloadResult waiterResult = result;
+    waiterResult.bytesCount = 0;
+    if (result.isSuccess)
+    {
+      try
+      {
+        waiterResult.isSuccess = m_place(task.request, waiter.request);
+      }
+      catch (std::exception const & exception)
+      {
+        SC_LOG_ERROR(exception.what());
+        waiterResult.isSuccess = false;
+      }
+
+      if (!waiterResult.isSuccess)
+        SC_LOG_ERROR(
+            "DownloadScheduler: Can't place \"" + task.request.url + "\" into \"" + waiter.request.downloadPath + "\"");
+    }
+
+    waiter.promise->set_value(waiterResult);
+  }
+}
+
+/**
+ * @brief Copy downloaded files of request into target of other request
+ * @param downloadedRequest downloaded request
+ * @param request request of the same source with other target
+ * @return true if files are copied
+ */
+bool DownloadScheduler::PlaceDirectory(DownloadRequest const & downloadedRequest, DownloadRequest const & request)
+{
+  return componentUtils::FileUtils::ReplaceDirectory(downloadedRequest.downloadPath, request.downloadPath, false);
+}
+
+/**
+ * @brief Wait for task that is ready to be downloaded and whose host has free connection
+ * @param lock locked lock of scheduler mutex
+ * @param task taken task
+ * @return false if scheduler is stopped
+ */
+bool DownloadScheduler::TakeTask(std::unique_lock<std::mutex> & lock, Task & task)
+{
+  while (!m_isStopped)
+  {
+    Clock::time_point const now = Clock::now();
+    Clock::time_point nextReadyTime = Clock::time_point::max();
+
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
+    {
+      if (m_hostConnections[it->host] >= m_hostConnectionsLimit)
+        continue;
+
+      if (it->readyTime > now)
+      {
+        nextReadyTime = std::min(nextReadyTime, it->readyTime);
+        continue;
+      }
+
+      task = std::move(*it);
+      m_tasks.erase(it);
+      ++m_hostConnections[task.host];
+      return true;
+    }
+
+    if (nextReadyTime == Clock::time_point::max())
+      m_tasksChanged.wait(lock);
+    else
+      m_tasksChanged.wait_until(lock, nextReadyTime);
+  }
+
+  return false;
+}
+
+/**
+ * @brief Get delay before the next attempt. Delay is doubled after each attempt,
+ * half of it is random, so requests that failed together aren't retried together.
+ * @param attemptsCount count of failed attempts
+ * @return Delay before the next attempt
+ */
+std::chrono::milliseconds DownloadScheduler::GetRetryDelay(size_t attemptsCount)
+{
+  size_t constexpr kMaxExponent = 10;
+
+  std::chrono::milliseconds const delay = m_retryDelay * (1ull << std::min(attemptsCount - 1, kMaxExponent));
+  std::uniform_int_distribution<long long> jitter(0, delay.count() / 2);
+  return delay / 2 + std::chrono::milliseconds(jitter(m_random));
+}
+
+/**
+ * @brief Get key of request, requests with equal keys download
+ * the same source, their targets can differ. Expected checksum is a part of key,
+ * so request isn't placed from download that is verified by other checksum.
+ * @param request download request
+ * @return Key of request
+ */
+std::string DownloadScheduler::GetRequestKey(DownloadRequest const & request)
+{
+  return componentUtils::UrlUtils::NormalizeUrl(request.url) + '\n' + request.pathPostfix + '\n' + request.revision +
+         '\n' + request.checksum;
+}
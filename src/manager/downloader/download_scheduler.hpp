@@ -0,0 +1,128 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "download_request.hpp"
+#include "src/manager/sc_component_manager_settings.hpp"
+
+struct DownloadStatistics
+{
+  size_t requestsCount = 0;
+  size_t failedRequestsCount = 0;
+  size_t retriesCount = 0;
+  // Count of requests that were merged with the same request in flight
+  size_t collapsedRequestsCount = 0;
+  size_t bytesCount = 0;
+  std::chrono::milliseconds totalLatency{0};
+  std::chrono::milliseconds maxLatency{0};
+
+  std::string ToString() const
+  {
+    return std::to_string(requestsCount) + " requests, " + std::to_string(failedRequestsCount) + " failed, " +
+           std::to_string(retriesCount) + " retries, " + std::to_string(collapsedRequestsCount) + " collapsed, " +
+           std::to_string(bytesCount) + " bytes, max latency " +
+           std::to_string(maxLatency.count()) + " ms, total latency " + std::to_string(totalLatency.count()) + " ms";
+  }
+};
+
+/**
+ * @brief Runs download requests concurrently. Count of simultaneous
+ * downloads from one host is limited, downloads that failed transiently are retried
+ * after exponentially growing delay with random jitter. Requests of the same
+ * source that are submitted while it is in flight share its download: source is
+ * downloaded once and then it is placed into targets of other requests.
+ */
+class DownloadScheduler
+{
+public:
+  // Download function makes one attempt to download request
+  using DownloadFunction = std::function<DownloadAttempt(DownloadRequest const &)>;
+  // Place function copies downloaded request into target of other request of the same source
+  using PlaceFunction = std::function<bool(DownloadRequest const &, DownloadRequest const &)>;
+
+  DownloadScheduler(
+      DownloadFunction download,
+      ScComponentManagerSettings const & settings,
+      PlaceFunction place = &DownloadScheduler::PlaceDirectory);
+
+  ~DownloadScheduler();
+
+  std::shared_future<DownloadResult> Submit(DownloadRequest const & request);
+
+  DownloadStatistics GetStatistics() const;
+
+protected:
+  using Clock = std::chrono::steady_clock;
+
+  struct Task
+  {
+    DownloadRequest request;
+    std::string key;
+    std::string host;
+    size_t attemptsCount = 0;
+    Clock::time_point submitTime;
+    Clock::time_point readyTime;
+    std::shared_ptr<std::promise<DownloadResult>> result;
+  };
+
+  // Request of the same source as downloaded one, but with other target
+  struct Waiter
+  {
+    DownloadRequest request;
+    std::shared_ptr<std::promise<DownloadResult>> promise;
+    std::shared_future<DownloadResult> result;
+  };
+
+  struct InFlightDownload
+  {
+    std::string downloadPath;
+    std::shared_future<DownloadResult> result;
+    std::list<Waiter> waiters;
+  };
+
+  DownloadFunction m_download;
+  PlaceFunction m_place;
+  size_t m_hostConnectionsLimit;
+  size_t m_retriesCount;
+  std::chrono::milliseconds m_retryDelay;
+
+  std::list<Task> m_tasks;
+  std::map<std::string, size_t> m_hostConnections;
+  std::map<std::string, InFlightDownload> m_inFlightDownloads;
+  DownloadStatistics m_statistics;
+  std::mt19937 m_random;
+  bool m_isStopped = false;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_tasksChanged;
+  std::vector<std::thread> m_workers;
+
+  void Work();
+
+  bool TakeTask(std::unique_lock<std::mutex> & lock, Task & task);
+
+  std::chrono::milliseconds GetRetryDelay(size_t attemptsCount);
+
+  void CompleteWaiters(Task const & task, std::list<Waiter> & waiters, DownloadResult const & result);
+
+  static bool PlaceDirectory(DownloadRequest const & downloadedRequest, DownloadRequest const & request);
+
+  static std::string GetRequestKey(DownloadRequest const & request);
+};
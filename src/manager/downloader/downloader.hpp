@@ -7,14 +7,81 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include "download_request.hpp"
+
+#include "src/manager/utils/content_digest.hpp"
 
 class Downloader
 {
 public:
-  virtual void Download(
+  /**
+   * @brief Download source into directory
+   * @param downloadPath directory where source is placed
+   * @param urlAddress url of source
+   * @param pathPostfix path in source, the whole source is downloaded if it is empty
+   * @return Downloaded status if source is downloaded, permanent failure if retry fails
+   * again, e.g. source isn't found
+   */
+  virtual DownloadStatus Download(
       std::string const & downloadPath,
       std::string const & urlAddress,
       std::string const & pathPostfix = "") = 0;
 
+  /**
+   * @brief Download source into directory and get its checksum. Downloaders that
+   * can't hash data while it is written read downloaded source after download.
+   * @param downloadPath directory where source is placed
+   * @param urlAddress url of source
+   * @param pathPostfix path in source, the whole source is downloaded if it is empty
+   * @param checksum checksum of downloaded source, see componentUtils::ContentDigest
+   * @return Status of download, see Download
+   */
+  virtual DownloadStatus DownloadWithChecksum(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      std::string & checksum)
+  {
+    DownloadStatus const status = Download(downloadPath, urlAddress, pathPostfix);
+    if (status != DownloadStatus::Downloaded)
+      return status;
+
+    checksum = componentUtils::ContentDigest::GetPathHash(
+        pathPostfix.empty() ? downloadPath : downloadPath + "/" + pathPostfix);
+    return status;
+  }
+
+  /**
+   * @brief Get current revision of source
+   * @param urlAddress url of source
+   * @return Revision identifier, return empty string if revision is unknown
+   */
+  virtual std::string GetRevision(std::string const & /* urlAddress */)
+  {
+    return "";
+  }
+
+  /**
+   * @brief Update downloaded source to current revision in place.
+   * Only files changed since downloaded revision are transferred.
+   * @param downloadPath directory where source is downloaded
+   * @param urlAddress url of source
+   * @param revision revision of source in directory
+   * @param currentRevision revision that directory is updated to
+   * @param changedPaths paths of added and changed files relative to directory
+   * @return false if source can't be updated by changes, then it has to be downloaded again
+   */
+  virtual bool DownloadChanges(
+      std::string const & /* downloadPath */,
+      std::string const & /* urlAddress */,
+      std::string const & /* revision */,
+      std::string & /* currentRevision */,
+      std::vector<std::string> & /* changedPaths */)
+  {
+    return false;
+  }
+
   virtual ~Downloader() = default;
 };
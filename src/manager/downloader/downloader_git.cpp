@@ -0,0 +1,465 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "downloader_git.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
+#include "src/manager/utils/sc_component_utils.hpp"
+#include "src/manager/utils/tar_extractor.hpp"
+
+DownloaderGit::DownloaderGit(
+    std::string cachePath,
+    std::shared_ptr<componentUtils::ProcessRunner> processRunner,
+    std::chrono::milliseconds timeout)
+  : m_cachePath(std::move(cachePath))
+  , m_processRunner(std::move(processRunner))
+  , m_timeout(timeout)
+{
+}
+
+/**
+ * @brief Download requested path of repository
+ * @param downloadPath directory where requested path is placed
+ * @param urlAddress url of git repository
+ * @param pathPostfix path in repository, the whole repository is downloaded if it is empty
+ * @return Status of download, see DownloadWithChecksum
+ */
+DownloadStatus DownloaderGit::Download(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix)
+{
+  std::string checksum;
+  return DownloadWithChecksum(downloadPath, urlAddress, pathPostfix, checksum);
+}
+
+/**
+ * @brief Download requested path of repository and hash its files while they are extracted
+ * @param downloadPath directory where requested path is placed
+ * @param urlAddress url of git repository
+ * @param pathPostfix path in repository, the whole repository is downloaded if it is empty
+ * @param checksum checksum of extracted files, see componentUtils::ContentDigest
+ * @return Downloaded status if requested path is extracted, permanent failure
+ * if repository or requested path isn't found
+ */
+DownloadStatus DownloaderGit::DownloadWithChecksum(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix,
+    std::string & checksum)
+{
+  if (!sc_fs_mkdirs(downloadPath.c_str()))
+  {
+    SC_LOG_ERROR("Can't download. Can't create folder.");
+    return DownloadStatus::Failed;
+  }
+
+  std::string const repositoryPath = GetRepositoryPath(urlAddress);
+  std::lock_guard<std::mutex> lock(GetRepositoryMutex(repositoryPath));
+
+  std::string reference;
+  DownloadStatus status = FetchRepository(urlAddress, !pathPostfix.empty(), reference);
+  if (status != DownloadStatus::Downloaded)
+  {
+    SC_LOG_ERROR("Can't download. Can't fetch \"" + urlAddress + "\"");
+    return status;
+  }
+
+  // Archive doesn't change index of cache repository, missing blobs of requested path are fetched on demand
+  std::vector<std::string> archiveArguments = {
+      "git", "--git-dir=" + repositoryPath, "archive", "--format=tar", reference};
+  if (!pathPostfix.empty())
+    archiveArguments.insert(archiveArguments.end(), {"--", pathPostfix});
+
+  status = ExtractArchive(archiveArguments, downloadPath, pathPostfix, checksum);
+  if (status != DownloadStatus::Downloaded)
+    return status;
+
+  std::string const requestedPath = downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + pathPostfix;
+  bool const isExtracted = pathPostfix.empty()
+                               ? !componentUtils::FileUtils::IsDirectoryEmpty(downloadPath)
+                               : sc_fs_isfile(requestedPath.c_str()) ||
+                                     componentUtils::FileUtils::IsDirectory(requestedPath);
+  return isExtracted ? DownloadStatus::Downloaded : DownloadStatus::FailedPermanently;
+}
+
+/**
+ * @brief Get revision of repository HEAD
+ * @param urlAddress url of git repository
+ * @return Hash of HEAD commit, return empty string if repository isn't available
+ */
+std::string DownloaderGit::GetRevision(std::string const & urlAddress)
+{
+  size_t constexpr kRevisionSize = 40;
+
+  componentUtils::ProcessResult const result = RunProcess({"git", "ls-remote", "--", urlAddress, "HEAD"}, true);
+  if (!result.IsSuccess() && GetFailureStatus(result) == DownloadStatus::FailedPermanently)
+    SC_LOG_WARNING("DownloaderGit: Repository \"" + urlAddress + "\" isn't found");
+  if (!result.IsSuccess() || result.output.size() < kRevisionSize)
+    return "";
+
+  return result.output.substr(0, kRevisionSize);
+}
+
+std::mutex & DownloaderGit::GetRepositoryMutex(std::string const & repositoryPath)
+{
+  std::lock_guard<std::mutex> lock(m_repositoriesMutex);
+  std::unique_ptr<std::mutex> & repositoryMutex = m_repositoriesMutexes[repositoryPath];
+  if (!repositoryMutex)
+    repositoryMutex = std::make_unique<std::mutex>();
+  return *repositoryMutex;
+}
+
+/**
+ * @brief Update downloaded repository by diff between downloaded and current commits.
+ * Trees of both commits are fetched without blobs, so only blobs of changed files are
+ * transferred. Files that are removed in current commit are removed from directory
+ * with their directories that become empty.
+ * @param downloadPath directory where repository is downloaded
+ * @param urlAddress url of git repository
+ * @param revision hash of downloaded commit
+ * @param currentRevision hash of current commit
+ * @param changedPaths paths of added and changed files relative to directory
+ * @return false if diff can't be made, then repository has to be downloaded again
+ */
+bool DownloaderGit::DownloadChanges(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & revision,
+    std::string & currentRevision,
+    std::vector<std::string> & changedPaths)
+{
+  size_t constexpr kRevisionSize = 40;
+
+  std::string const repositoryPath = GetRepositoryPath(urlAddress);
+  std::lock_guard<std::mutex> lock(GetRepositoryMutex(repositoryPath));
+
+  std::string reference;
+  if (FetchRepository(urlAddress, true, reference) != DownloadStatus::Downloaded)
+    return false;
+
+  componentUtils::ProcessResult const revisionResult =
+      RunProcess({"git", "--git-dir=" + repositoryPath, "rev-parse", reference}, true);
+  if (!revisionResult.IsSuccess() || revisionResult.output.size() < kRevisionSize)
+    return false;
+
+  currentRevision = revisionResult.output.substr(0, kRevisionSize);
+  changedPaths.clear();
+  if (currentRevision == revision)
+    return true;
+
+  if (!FetchRevision(repositoryPath, revision))
+    return false;
+
+  componentUtils::ProcessResult const diffResult = RunProcess(
+      {"git",
+       "--git-dir=" + repositoryPath,
+       "diff-tree",
+       "-r",
+       "-z",
+       "--no-renames",
+       "--name-status",
+       revision,
+       currentRevision},
+      true);
+  if (!diffResult.IsSuccess())
+    return false;
+
+  std::vector<std::string> removedPaths;
+  ParseChanges(diffResult.output, changedPaths, removedPaths);
+  for (std::string const & removedPath : removedPaths)
+    RemoveFile(downloadPath, removedPath);
+
+  for (size_t begin = 0; begin < changedPaths.size(); begin += kArchivePathsCount)
+  {
+    std::vector<std::string> archiveArguments = {
+        "git", "--git-dir=" + repositoryPath, "archive", "--format=tar", currentRevision, "--"};
+    size_t const end = std::min(begin + kArchivePathsCount, changedPaths.size());
+    archiveArguments.insert(archiveArguments.end(), changedPaths.cbegin() + begin, changedPaths.cbegin() + end);
+
+    std::string checksum;
+    if (ExtractArchive(archiveArguments, downloadPath, "", checksum) != DownloadStatus::Downloaded)
+      return false;
+  }
+
+  SC_LOG_DEBUG(
+      "DownloaderGit: \"" + urlAddress + "\" is updated, " + std::to_string(changedPaths.size()) +
+      " files are changed, " + std::to_string(removedPaths.size()) + " files are removed");
+  return true;
+}
+
+/**
+ * @brief Parse output of `git diff-tree -z --name-status`
+ * @param diffOutput output of git, status and path are separated by zero symbols
+ * @param changedPaths paths of added and changed files
+ * @param removedPaths paths of removed files
+ */
+void DownloaderGit::ParseChanges(
+    std::string const & diffOutput,
+    std::vector<std::string> & changedPaths,
+    std::vector<std::string> & removedPaths)
+{
+  char const DELETED_STATUS = 'D';
+
+  size_t statusBegin = 0;
+  while (statusBegin < diffOutput.size())
+  {
+    size_t const statusEnd = diffOutput.find('\0', statusBegin);
+    if (statusEnd == std::string::npos)
+      return;
+
+    size_t const pathBegin = statusEnd + 1;
+    size_t pathEnd = diffOutput.find('\0', pathBegin);
+    if (pathEnd == std::string::npos)
+      pathEnd = diffOutput.size();
+
+    std::string const path = diffOutput.substr(pathBegin, pathEnd - pathBegin);
+    if (statusEnd > statusBegin && !path.empty())
+    {
+      if (diffOutput[statusBegin] == DELETED_STATUS)
+        removedPaths.push_back(path);
+      else
+        changedPaths.push_back(path);
+    }
+
+    statusBegin = pathEnd + 1;
+  }
+}
+
+/**
+ * @brief Remove file of downloaded repository and its parent directories that become empty
+ * @param downloadPath directory where repository is downloaded, it isn't removed
+ * @param relativePath path of file relative to directory
+ */
+void DownloaderGit::RemoveFile(std::string const & downloadPath, std::string const & relativePath)
+{
+  std::remove((downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + relativePath).c_str());
+
+  for (size_t directoryEnd = relativePath.rfind(SpecificationConstants::DIRECTORY_DELIMETR);
+       directoryEnd != std::string::npos && directoryEnd != 0;
+       directoryEnd = relativePath.rfind(SpecificationConstants::DIRECTORY_DELIMETR, directoryEnd - 1))
+  {
+    std::string const directoryPath =
+        downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + relativePath.substr(0, directoryEnd);
+    if (!componentUtils::FileUtils::IsDirectory(directoryPath) ||
+        !componentUtils::FileUtils::IsDirectoryEmpty(directoryPath))
+      return;
+
+    componentUtils::FileUtils::RemoveDirectory(directoryPath);
+  }
+}
+
+/**
+ * @brief Check if bare repository cache is cloned without blobs
+ * @param repositoryPath path of bare repository
+ * @return true if missing blobs of repository are fetched on demand
+ */
+bool DownloaderGit::IsPartialRepository(std::string const & repositoryPath)
+{
+  // Promisor remote is set by git for partial clones only, missing option isn't logged as failure
+  componentUtils::ProcessOptions options;
+  options.arguments = {"git", "--git-dir=" + repositoryPath, "config", "--get", "remote.origin.promisor"};
+  options.timeout = m_timeout;
+  options.isOutputCaptured = true;
+  componentUtils::ProcessResult const result = m_processRunner->Run(options);
+  return result.IsSuccess() && result.output.find("true") == 0;
+}
+
+/**
+ * @brief Make commit available in bare repository cache. Only trees of commit are fetched
+ * into partial cache, because history of cache is shallow and previous commits aren't kept.
+ * @param repositoryPath path of bare repository
+ * @param revision hash of commit
+ * @return true if commit is in repository
+ */
+bool DownloaderGit::FetchRevision(std::string const & repositoryPath, std::string const & revision)
+{
+  componentUtils::ProcessOptions options;
+  options.arguments = {"git", "--git-dir=" + repositoryPath, "cat-file", "-e", revision + "^{commit}"};
+  options.timeout = m_timeout;
+  options.isOutputCaptured = true;
+  if (m_processRunner->Run(options).IsSuccess())
+    return true;
+
+  std::vector<std::string> fetchArguments = {"git", "--git-dir=" + repositoryPath, "fetch", "--quiet", "--depth", "1"};
+  if (IsPartialRepository(repositoryPath))
+    fetchArguments.push_back("--filter=blob:none");
+  fetchArguments.insert(fetchArguments.end(), {"origin", revision});
+
+  return RunProcess(fetchArguments).IsSuccess();
+}
+
+/**
+ * @brief Fetch the last commit of repository into bare repository cache.
+ * If repository is already cached, then only changes are fetched. Cache that is cloned
+ * without blobs stays partial, it is cloned again with blobs if the whole repository is requested,
+ * otherwise every blob of repository would be fetched by separate request.
+ * @param urlAddress url of git repository
+ * @param isSparse if true, then blobs aren't fetched until they are read
+ * @param reference reference to fetched commit
+ * @return Status of fetch, permanent failure if repository isn't found
+ */
+DownloadStatus DownloaderGit::FetchRepository(std::string const & urlAddress, bool isSparse, std::string & reference)
+{
+  std::string const HEAD_FILENAME = "HEAD";
+  std::string const FETCH_HEAD_FILENAME = "FETCH_HEAD";
+  std::string const BLOBLESS_FILTER = "--filter=blob:none";
+
+  std::string const repositoryPath = GetRepositoryPath(urlAddress);
+  std::string const headPath = repositoryPath + SpecificationConstants::DIRECTORY_DELIMETR + HEAD_FILENAME;
+
+  bool const isPartial = sc_fs_isfile(headPath.c_str()) && IsPartialRepository(repositoryPath);
+  if (isPartial && !isSparse)
+  {
+    SC_LOG_DEBUG("DownloaderGit: Partial cache of \"" + urlAddress + "\" is cloned again with blobs");
+    componentUtils::FileUtils::RemoveDirectory(repositoryPath);
+  }
+
+  if (!sc_fs_isfile(headPath.c_str()))
+  {
+    std::vector<std::string> cloneArguments = {"git", "clone", "--quiet", "--bare", "--depth", "1"};
+    if (isSparse)
+      cloneArguments.push_back(BLOBLESS_FILTER);
+    cloneArguments.insert(cloneArguments.end(), {"--", urlAddress, repositoryPath});
+
+    componentUtils::ProcessResult const cloneResult = RunProcess(cloneArguments);
+    if (cloneResult.IsSuccess())
+    {
+      reference = HEAD_FILENAME;
+      return DownloadStatus::Downloaded;
+    }
+
+    // Partially cloned repository isn't reused
+    componentUtils::FileUtils::RemoveDirectory(repositoryPath);
+    return GetFailureStatus(cloneResult);
+  }
+
+  // Full cache isn't turned into partial one, because filter is saved by git for the next fetches
+  std::vector<std::string> fetchArguments = {"git", "--git-dir=" + repositoryPath, "fetch", "--quiet", "--depth", "1"};
+  if (isPartial)
+    fetchArguments.push_back(BLOBLESS_FILTER);
+  fetchArguments.insert(fetchArguments.end(), {"origin", HEAD_FILENAME});
+
+  componentUtils::ProcessResult const fetchResult = RunProcess(fetchArguments);
+  if (!fetchResult.IsSuccess())
+    return GetFailureStatus(fetchResult);
+
+  reference = FETCH_HEAD_FILENAME;
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Extract archive that is written by git archive to its stdout. Archive isn't saved
+ * to disk, files are extracted and hashed while git writes them.
+ * @param archiveArguments git archive and its arguments
+ * @param downloadPath directory where files are extracted
+ * @param pathPostfix path in repository that is archived
+ * @param checksum checksum of extracted files
+ * @return Downloaded status if archive is extracted, permanent failure if archived path isn't found
+ */
+DownloadStatus DownloaderGit::ExtractArchive(
+    std::vector<std::string> const & archiveArguments,
+    std::string const & downloadPath,
+    std::string const & pathPostfix,
+    std::string & checksum)
+{
+  // Archive of git has no root directory and isn't compressed
+  componentUtils::TarExtractor extractor(downloadPath, pathPostfix, 0, false);
+  bool isWritten = true;
+
+  componentUtils::ProcessOptions options;
+  options.arguments = archiveArguments;
+  options.timeout = m_timeout;
+  options.outputConsumer = [&extractor, &isWritten](char const * data, size_t size)
+  {
+    isWritten = extractor.Write(data, size);
+    return isWritten;
+  };
+
+  componentUtils::ProcessResult const result = m_processRunner->Run(options);
+  if (!isWritten)
+  {
+    SC_LOG_ERROR("DownloaderGit: Can't extract archive into \"" + downloadPath + "\"");
+    return DownloadStatus::Failed;
+  }
+  if (!result.IsSuccess())
+  {
+    SC_LOG_WARNING("DownloaderGit: \"" + archiveArguments.front() + "\" failed, " + result.ToString());
+    return GetFailureStatus(result);
+  }
+  if (!extractor.Finish())
+    return DownloadStatus::Failed;
+
+  checksum = extractor.GetContentHash();
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Classify failure of git by its errors. Git exits with the same code
+ * for missing repository and for broken connection, so its messages are checked.
+ * @param result result of failed git
+ * @return Permanent failure if repository or requested path isn't found, failure otherwise
+ */
+DownloadStatus DownloaderGit::GetFailureStatus(componentUtils::ProcessResult const & result)
+{
+  std::vector<std::string> const MISSING_SOURCE_ERRORS = {
+      // Repository of hosting isn't found
+      "not found",
+      // Local path or server path isn't a repository
+      "does not appear to be a git repository",
+      // Requested path isn't in archived commit
+      "did not match any files"};
+
+  if (!result.isStarted || result.isTimedOut || result.signal != 0)
+    return DownloadStatus::Failed;
+
+  for (std::string const & error : MISSING_SOURCE_ERRORS)
+  {
+    if (result.errorOutput.find(error) != std::string::npos)
+      return DownloadStatus::FailedPermanently;
+  }
+  return DownloadStatus::Failed;
+}
+
+/**
+ * @brief Run git and log its failure
+ * @param arguments program and its arguments
+ * @param isOutputCaptured if true, then program output is returned instead of logging
+ * @return Result of program
+ */
+componentUtils::ProcessResult DownloaderGit::RunProcess(
+    std::vector<std::string> const & arguments,
+    bool isOutputCaptured)
+{
+  componentUtils::ProcessOptions options;
+  options.arguments = arguments;
+  options.timeout = m_timeout;
+  options.isOutputCaptured = isOutputCaptured;
+
+  componentUtils::ProcessResult const result = m_processRunner->Run(options);
+  if (!result.IsSuccess())
+    SC_LOG_WARNING("DownloaderGit: \"" + arguments.front() + "\" failed, " + result.ToString());
+
+  return result;
+}
+
+std::string DownloaderGit::GetRepositoryPath(std::string const & urlAddress) const
+{
+  return m_cachePath + SpecificationConstants::DIRECTORY_DELIMETR +
+         componentUtils::Hasher::GetStringHash(componentUtils::UrlUtils::NormalizeUrl(urlAddress)) + ".git";
+}
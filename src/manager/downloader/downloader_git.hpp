@@ -6,35 +6,86 @@
 
 #pragma once
 
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
-
-#include "sc-memory/utils/sc_exec.hpp"
+#include <vector>
 
 #include "downloader.hpp"
-#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+#include "src/manager/utils/process_runner.hpp"
 
+/**
+ * @brief Downloads sources from git repositories. Each repository is fetched
+ * shallowly into local bare repository cache, so the next downloads
+ * of the same repository transfer only changes. Only requested path
+ * is taken from the cache: blobs of other files aren't downloaded
+ * if single file is requested.
+ */
 class DownloaderGit : public Downloader
 {
 public:
-  void Download(std::string const & downloadPath, std::string const & urlAddress, std::string const & pathPostfix = "")
-      override
-  {
-    std::string path = downloadPath;
-    std::stringstream query;
-    query << urlAddress << GitHubConstants::SVN_TRUNK << SpecificationConstants::DIRECTORY_DELIMETR << pathPostfix;
-    if (pathPostfix.empty())
-    {
-      size_t const componentDirNameIndex = downloadPath.rfind('/');
-      query << "  " << downloadPath.substr(componentDirNameIndex + 1);
-      path = downloadPath.substr(0, componentDirNameIndex);
-    }
-
-    if (!sc_fs_mkdirs(path.c_str()))
-    {
-      SC_LOG_ERROR("Can't download. Can't create folder.");
-      return;
-    }
-
-    ScExec exec{{"cd", path, "&&", "svn", "export", query.str()}};
-  }
+  DownloaderGit(
+      std::string cachePath,
+      std::shared_ptr<componentUtils::ProcessRunner> processRunner,
+      std::chrono::milliseconds timeout);
+
+  DownloadStatus Download(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix = "") override;
+
+  DownloadStatus DownloadWithChecksum(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      std::string & checksum) override;
+
+  std::string GetRevision(std::string const & urlAddress) override;
+
+  bool DownloadChanges(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & revision,
+      std::string & currentRevision,
+      std::vector<std::string> & changedPaths) override;
+
+  static void ParseChanges(
+      std::string const & diffOutput,
+      std::vector<std::string> & changedPaths,
+      std::vector<std::string> & removedPaths);
+
+protected:
+  // Count of paths that are passed to one git archive
+  static size_t constexpr kArchivePathsCount = 512;
+
+  std::string m_cachePath;
+  std::shared_ptr<componentUtils::ProcessRunner> m_processRunner;
+  std::chrono::milliseconds m_timeout;
+
+  std::mutex m_repositoriesMutex;
+  std::map<std::string, std::unique_ptr<std::mutex>> m_repositoriesMutexes;
+
+  std::mutex & GetRepositoryMutex(std::string const & repositoryPath);
+
+  DownloadStatus FetchRepository(std::string const & urlAddress, bool isSparse, std::string & reference);
+
+  std::string GetRepositoryPath(std::string const & urlAddress) const;
+
+  bool FetchRevision(std::string const & repositoryPath, std::string const & revision);
+
+  bool IsPartialRepository(std::string const & repositoryPath);
+
+  static void RemoveFile(std::string const & downloadPath, std::string const & relativePath);
+
+  DownloadStatus ExtractArchive(
+      std::vector<std::string> const & archiveArguments,
+      std::string const & downloadPath,
+      std::string const & pathPostfix,
+      std::string & checksum);
+
+  static DownloadStatus GetFailureStatus(componentUtils::ProcessResult const & result);
+
+  componentUtils::ProcessResult RunProcess(std::vector<std::string> const & arguments, bool isOutputCaptured = false);
 };
@@ -13,8 +13,10 @@
 class DownloaderGoogleDrive : public Downloader
 {
 public:
-  void Download(std::string const & urlAddress, std::string const & downloadPath, std::string const & pathPostfix = "")
-      override
+  DownloadStatus Download(
+      std::string const & urlAddress,
+      std::string const & downloadPath,
+      std::string const & pathPostfix = "") override
   {
     // std::string const gDriveFileId = componentPath.substr(
     //     GoogleDriveConstants::GOOGLE_DRIVE_FILE_PREFIX.size(),
@@ -26,5 +28,6 @@ public:
     //                                          + gDriveInstallCommandParameter;
 
     // ScExec exec{{gDriveInstallCommand}};
+    return DownloadStatus::FailedPermanently;
   }
 };
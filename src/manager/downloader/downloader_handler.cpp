@@ -6,6 +6,9 @@
 
 #include <sc-builder/src/scs_loader.hpp>
 #include <sc-agents-common/utils/CommonUtils.hpp>
+#include "src/manager/utils/content_digest.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
 #include "src/manager/utils/sc_component_utils.hpp"
 #include "downloader_handler.hpp"
 
@@ -50,7 +53,8 @@ ScAddr DownloaderHandler::getUrlLinkClass(ScMemoryContext * context, ScAddr cons
 
   ScAddrVector const downloadableUrls = {
       keynodes::ScComponentManagerKeynodes::concept_github_url,
-      keynodes::ScComponentManagerKeynodes::concept_google_drive_url};
+      keynodes::ScComponentManagerKeynodes::concept_google_drive_url,
+      keynodes::ScComponentManagerKeynodes::concept_http_url};
 
   for (ScAddr const & currentClass : downloadableUrls)
   {
@@ -63,24 +67,79 @@ ScAddr DownloaderHandler::getUrlLinkClass(ScMemoryContext * context, ScAddr cons
   return urlLinkClass;
 }
 
+/**
+ * @brief Create downloaders for supported url classes. Keynodes are initialized
+ * after handler is created, so downloaders are created on the first download.
+ */
+void DownloaderHandler::InitDownloaders()
+{
+  std::string const cachePath =
+      m_downloadDir + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::CACHE_DIRECTORY;
+
+  m_downloaders = {
+      {keynodes::ScComponentManagerKeynodes::concept_github_url,
+       new DownloaderGit(
+           cachePath + SpecificationConstants::DIRECTORY_DELIMETR + GitHubConstants::GIT_CACHE_DIRECTORY,
+           m_processRunner,
+           m_gitTimeout)},
+      {keynodes::ScComponentManagerKeynodes::concept_google_drive_url, new DownloaderGoogleDrive()},
+      {keynodes::ScComponentManagerKeynodes::concept_http_url, new DownloaderHttp()}};
+  m_tarballDownloader = std::make_unique<DownloaderTarball>();
+}
+
+/**
+ * @brief Get downloader for url class
+ * @param urlClassAddr sc-addr of url class
+ * @return Downloader, return nullptr if url class isn't supported
+ */
+Downloader * DownloaderHandler::GetDownloader(ScAddr const & urlClassAddr)
+{
+  std::call_once(m_downloadersInitialized, &DownloaderHandler::InitDownloaders, this);
+
+  auto const & it = m_downloaders.find(urlClassAddr);
+  return it == m_downloaders.cend() ? nullptr : it->second;
+}
+
 DownloaderHandler::~DownloaderHandler()
 {
+  // Workers of scheduler use downloaders, so they are stopped first
+  m_scheduler.reset();
+  CollectAbandonedAlternatives(true);
+  m_mirrorStatistics.Save();
+
   for (auto const & it : m_downloaders)
     delete it.second;
 }
 
-void DownloaderHandler::Download(ScMemoryContext * context, ScAddr const & nodeAddr)
+/**
+ * @brief Download node from the first alternative address that succeeds
+ * @param context current sc-memory context
+ * @param nodeAddr sc-addr of node to download
+ * @return true if node is downloaded from one of its addresses
+ */
+bool DownloaderHandler::Download(ScMemoryContext * context, ScAddr const & nodeAddr)
+{
+  return DownloadAlternatives(GetDownloadRequests(context, nodeAddr)).isSuccess;
+}
+
+/**
+ * @brief Find addresses of node and resolve them to download requests
+ * @param context current sc-memory context
+ * @param nodeAddr sc-addr of node to download
+ * @return Vector of download requests, return empty vector
+ * if node can't be downloaded
+ */
+std::vector<DownloadRequest> DownloaderHandler::GetDownloadRequests(ScMemoryContext * context, ScAddr const & nodeAddr)
 {
+  std::vector<DownloadRequest> requests;
   ScAddrVector nodeAddressLinkAddrs;
-  std::string pathPostfix;
   std::string specificationPostfix;
-  std::string url;
 
   ScAddr const & nodeClassAddr = getDownloadableClass(context, nodeAddr);
   if (!nodeClassAddr.IsValid())
   {
     SC_LOG_ERROR("Can't download. Downloadable class not found");
-    return;
+    return requests;
   }
 
   std::string nodeSystIdtf = context->HelperGetSystemIdtf(nodeAddr);
@@ -118,14 +177,529 @@ void DownloaderHandler::Download(ScMemoryContext * context, ScAddr const & nodeA
 
   for (ScAddr const & currentAddressLinkAddr : nodeAddressLinkAddrs)
   {
-    ScAddr const & linkAddressClassAddr = getUrlLinkClass(context, currentAddressLinkAddr);  // TODO: not safe method
-    if (linkAddressClassAddr == keynodes::ScComponentManagerKeynodes::concept_github_url)
+    DownloadRequest request;
+    request.urlClassAddr = getUrlLinkClass(context, currentAddressLinkAddr);  // TODO: not safe method
+    context->GetLinkContent(currentAddressLinkAddr, request.url);
+    if (request.urlClassAddr == keynodes::ScComponentManagerKeynodes::concept_github_url ||
+        request.urlClassAddr == keynodes::ScComponentManagerKeynodes::concept_http_url ||
+        DownloaderLocal::IsLocalUrl(request.url))
     {
-      context->GetLinkContent(currentAddressLinkAddr, url);
-      pathPostfix = specificationPostfix;
+      request.systemIdtf = nodeSystIdtf;
+      request.downloadPath = downloadPath;
+      request.pathPostfix = specificationPostfix;
+      request.checksum = componentUtils::SearchUtils::GetAddressChecksum(context, currentAddressLinkAddr);
 
-      std::unique_ptr<Downloader> downloader = std::make_unique<DownloaderGit>();
-      downloader->Download(downloadPath, url, pathPostfix);
+      requests.push_back(request);
     }
   }
+
+  return requests;
+}
+
+/**
+ * @brief Resolve address of repository index file.
+ * Repository address without url class is supposed to be GitHub url.
+ * @param context current sc-memory context
+ * @param repositoryAddr sc-addr of repository
+ * @param request download request of index file
+ * @return false if repository has no address
+ */
+bool DownloaderHandler::GetRepositoryIndexRequest(
+    ScMemoryContext * context,
+    ScAddr const & repositoryAddr,
+    DownloadRequest & request)
+{
+  ScAddr repositoryAddressLinkAddr;
+  try
+  {
+    repositoryAddressLinkAddr = componentUtils::SearchUtils::GetRepositoryAddress(context, repositoryAddr);
+  }
+  catch (utils::ScException const & exception)
+  {
+    SC_LOG_DEBUG(exception.Message());
+    return false;
+  }
+
+  context->GetLinkContent(repositoryAddressLinkAddr, request.url);
+  request.urlClassAddr = getUrlLinkClass(context, repositoryAddressLinkAddr);
+  if (!request.urlClassAddr.IsValid() && request.url.rfind(GitHubConstants::GITHUB_PREFIX, 0) == 0)
+    request.urlClassAddr = keynodes::ScComponentManagerKeynodes::concept_github_url;
+
+  if (request.url.empty() || (!request.urlClassAddr.IsValid() && !DownloaderLocal::IsLocalUrl(request.url)))
+    return false;
+
+  request.systemIdtf = context->HelperGetSystemIdtf(repositoryAddr);
+  request.downloadPath = m_downloadDir + SpecificationConstants::DIRECTORY_DELIMETR +
+                         SpecificationConstants::INDEXES_DIRECTORY + SpecificationConstants::DIRECTORY_DELIMETR +
+                         componentUtils::Hasher::GetStringHash(componentUtils::UrlUtils::NormalizeUrl(request.url));
+  request.pathPostfix = SpecificationConstants::INDEX_FILENAME;
+
+  return true;
+}
+
+/**
+ * @brief Add resolved address to download scheduler. It is safe
+ * to call this method from several threads.
+ * @param request download request
+ * @return Future result of download
+ */
+std::shared_future<DownloadResult> DownloaderHandler::Submit(DownloadRequest const & request)
+{
+  return m_scheduler->Submit(request);
+}
+
+/**
+ * @brief Download resolved address and wait for result.
+ * It is safe to call this method from several threads.
+ * @param request download request
+ * @return true if address is downloaded
+ */
+bool DownloaderHandler::Download(DownloadRequest const & request)
+{
+  return Submit(request).get().isSuccess;
+}
+
+/**
+ * @brief Race alternative addresses of the same source. Addresses are started
+ * in order of their statistics with staggered delay: the next address is started
+ * if the previous ones are failed or aren't downloaded during the delay.
+ * Each address is downloaded into its own directory, and the first succeeded one
+ * replaces requested directory. Statistics of addresses are saved on disk.
+ * @param requests download requests of alternative addresses with the same download path
+ * @return Result of the first succeeded address, or failed result if all addresses are failed
+ */
+DownloadResult DownloaderHandler::DownloadAlternatives(std::vector<DownloadRequest> const & requests)
+{
+  using Clock = std::chrono::steady_clock;
+  std::chrono::milliseconds constexpr kPollInterval{20};
+
+  if (requests.empty())
+    return {};
+  if (requests.size() == 1)
+    return Submit(requests.front()).get();
+
+  CollectAbandonedAlternatives(false);
+
+  std::vector<std::string> urls;
+  for (DownloadRequest const & request : requests)
+    urls.push_back(request.url);
+  std::vector<size_t> const order = m_mirrorStatistics.GetOrder(urls);
+
+  std::list<AbandonedAlternative> pendingAlternatives;
+  DownloadResult winnerResult;
+  std::string winnerPath;
+  size_t nextAlternative = 0;
+  Clock::time_point nextStartTime = Clock::now();
+
+  while (true)
+  {
+    for (auto it = pendingAlternatives.begin(); it != pendingAlternatives.end() && winnerPath.empty();)
+    {
+      if (it->result.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+      {
+        ++it;
+        continue;
+      }
+
+      DownloadResult const result = it->result.get();
+      m_mirrorStatistics.Update(result.url, result.isSuccess, result.latency);
+      if (result.isSuccess)
+      {
+        winnerResult = result;
+        winnerPath = it->path;
+      }
+      else
+      {
+        componentUtils::FileUtils::RemoveDirectory(it->path);
+        // Failed alternative doesn't hold back the next one
+        nextStartTime = Clock::now();
+      }
+      it = pendingAlternatives.erase(it);
+    }
+
+    if (!winnerPath.empty())
+      break;
+
+    Clock::time_point const now = Clock::now();
+    if (nextAlternative < order.size() && now >= nextStartTime)
+    {
+      DownloadRequest request = requests[order[nextAlternative++]];
+      std::string const path = m_cache.MakeStagingDirectory();
+      if (path.empty())
+      {
+        SC_LOG_WARNING("DownloaderHandler: Can't create directory for \"" + request.url + "\", it is skipped");
+        continue;
+      }
+
+      SC_LOG_DEBUG("DownloaderHandler: Start alternative \"" + request.url + "\"");
+      request.downloadPath = path;
+      pendingAlternatives.push_back({Submit(request), path});
+      nextStartTime = now + m_alternativeStaggerDelay;
+      continue;
+    }
+
+    if (pendingAlternatives.empty())
+      break;
+
+    std::chrono::milliseconds waitTime = kPollInterval;
+    if (nextAlternative < order.size())
+      waitTime = std::min(
+          waitTime,
+          std::chrono::duration_cast<std::chrono::milliseconds>(nextStartTime - now) + std::chrono::milliseconds(1));
+    pendingAlternatives.front().result.wait_for(waitTime);
+  }
+
+  if (!pendingAlternatives.empty())
+  {
+    std::lock_guard<std::mutex> lock(m_abandonedAlternativesMutex);
+    m_abandonedAlternatives.splice(m_abandonedAlternatives.end(), pendingAlternatives);
+  }
+
+  std::string const & downloadPath = requests.front().downloadPath;
+  if (winnerPath.empty())
+  {
+    SC_LOG_ERROR(
+        "Can't download \"" + downloadPath + "\" from any of " + std::to_string(requests.size()) + " addresses");
+    m_mirrorStatistics.Save();
+    return {};
+  }
+
+  // Winner directory is removed, so its files can be hardlinked
+  bool const isPlaced = componentUtils::FileUtils::ReplaceDirectory(winnerPath, downloadPath, true);
+  componentUtils::FileUtils::RemoveDirectory(winnerPath);
+  m_mirrorStatistics.Save();
+  if (!isPlaced)
+  {
+    SC_LOG_ERROR("Can't place \"" + winnerResult.url + "\" into \"" + downloadPath + "\"");
+    return {};
+  }
+
+  SC_LOG_DEBUG("DownloaderHandler: \"" + downloadPath + "\" is downloaded from \"" + winnerResult.url + "\"");
+  return winnerResult;
+}
+
+/**
+ * @brief Remember statistics of abandoned alternatives that are finished and remove their directories
+ * @param isWaited wait for alternatives that aren't finished
+ */
+void DownloaderHandler::CollectAbandonedAlternatives(bool isWaited)
+{
+  std::lock_guard<std::mutex> lock(m_abandonedAlternativesMutex);
+  for (auto it = m_abandonedAlternatives.begin(); it != m_abandonedAlternatives.end();)
+  {
+    if (!isWaited && it->result.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+    {
+      ++it;
+      continue;
+    }
+
+    DownloadResult const result = it->result.get();
+    if (result.attemptsCount > 0)
+      m_mirrorStatistics.Update(result.url, result.isSuccess, result.latency);
+    componentUtils::FileUtils::RemoveDirectory(it->path);
+    it = m_abandonedAlternatives.erase(it);
+  }
+}
+
+DownloadStatistics DownloaderHandler::GetStatistics() const
+{
+  return m_scheduler->GetStatistics();
+}
+
+/**
+ * @brief Make one attempt to download resolved address. Payload of known checksum
+ * or revision is taken from download cache, so the same payload is downloaded only once.
+ * Files are hashed while they are downloaded and compared with expected checksum.
+ * It is called by workers of download scheduler.
+ * @param request download request
+ * @return Status of attempt, downloaded revision and size of transferred files
+ */
+DownloadAttempt DownloaderHandler::Fetch(DownloadRequest const & request)
+{
+  DownloadAttempt attempt;
+  std::string const localUrl = GetLocalUrl(request.url);
+  if (!localUrl.empty())
+  {
+    // Copying of local source is as cheap as taking it from cache, so it isn't cached
+    SC_LOG_DEBUG("DownloaderHandler: \"" + request.url + "\" is copied from \"" + localUrl + "\"");
+    size_t copiedBytesCount = 0;
+    attempt.status = DownloadStaged(m_localDownloader, localUrl, request, "", copiedBytesCount);
+    return attempt;
+  }
+
+  // Specifications are only read, but components files can be changed by their install scripts
+  bool const isHardlinkAllowed = !request.pathPostfix.empty();
+  if (!request.checksum.empty() &&
+      m_cache.Materialize(
+          DownloadCache::GetContentKey(request.checksum, request.pathPostfix), request.downloadPath, isHardlinkAllowed))
+  {
+    SC_LOG_DEBUG("DownloaderHandler: \"" + request.url + "\" is taken from cache by its checksum");
+    attempt.status = DownloadStatus::Downloaded;
+    attempt.revision = request.revision;
+    return attempt;
+  }
+
+  Downloader * downloader = GetDownloader(request.urlClassAddr);
+  if (downloader == nullptr)
+  {
+    SC_LOG_ERROR("Can't download. Downloader for \"" + request.url + "\" not found");
+    attempt.status = DownloadStatus::FailedPermanently;
+    return attempt;
+  }
+
+  attempt.revision = request.revision.empty() ? downloader->GetRevision(request.url) : request.revision;
+  std::string url = request.url;
+  if (IsArchiveRequest(request))
+  {
+    downloader = m_tarballDownloader.get();
+    url = DownloaderTarball::GetArchiveUrl(request.url, attempt.revision);
+  }
+
+  // Payload without revision and checksum can't be found in cache, so it isn't stored
+  std::string key;
+  if (!request.checksum.empty())
+    key = DownloadCache::GetContentKey(request.checksum, request.pathPostfix);
+  else if (!attempt.revision.empty())
+    key = DownloadCache::GetKey(request.url, attempt.revision, request.pathPostfix);
+
+  if (request.checksum.empty() && !key.empty() && m_cache.Materialize(key, request.downloadPath, isHardlinkAllowed))
+  {
+    SC_LOG_DEBUG("DownloaderHandler: \"" + request.url + "\" is taken from cache");
+    attempt.status = DownloadStatus::Downloaded;
+    return attempt;
+  }
+
+  attempt.status = DownloadStaged(*downloader, url, request, key, attempt.bytesCount);
+  return attempt;
+}
+
+/**
+ * @brief Download url into staging directory, verify it and place it into requested directory.
+ * Requested directory isn't changed if download is failed or checksum differs.
+ * @param downloader downloader of url
+ * @param url url to download
+ * @param request download request
+ * @param key key of payload in download cache, payload isn't stored in cache if it is empty
+ * @param bytesCount size of downloaded files
+ * @return Status of download, see DownloadVerified
+ */
+DownloadStatus DownloaderHandler::DownloadStaged(
+    Downloader & downloader,
+    std::string const & url,
+    DownloadRequest const & request,
+    std::string const & key,
+    size_t & bytesCount)
+{
+  std::string const stagingPath = m_cache.MakeStagingDirectory();
+  if (stagingPath.empty())
+  {
+    SC_LOG_ERROR("Can't download. Can't create staging directory for \"" + request.url + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  DownloadStatus const status = DownloadVerified(downloader, stagingPath, url, request);
+  if (status != DownloadStatus::Downloaded || componentUtils::FileUtils::IsDirectoryEmpty(stagingPath))
+  {
+    componentUtils::FileUtils::RemoveDirectory(stagingPath);
+    return status == DownloadStatus::Downloaded ? DownloadStatus::Failed : status;
+  }
+
+  bytesCount = componentUtils::FileUtils::GetSize(stagingPath);
+  bool isPlaced;
+  if (key.empty())
+  {
+    // Staging directory is removed, so its files can be hardlinked
+    isPlaced = componentUtils::FileUtils::ReplaceDirectory(stagingPath, request.downloadPath, true);
+    componentUtils::FileUtils::RemoveDirectory(stagingPath);
+  }
+  else
+  {
+    // Specifications are only read, but components files can be changed by their install scripts
+    bool const isHardlinkAllowed = !request.pathPostfix.empty();
+    isPlaced = m_cache.Store(key, stagingPath) && m_cache.Materialize(key, request.downloadPath, isHardlinkAllowed);
+  }
+
+  if (!isPlaced)
+  {
+    SC_LOG_ERROR("Can't place \"" + request.url + "\" into \"" + request.downloadPath + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Place downloaded source into target of other request of the same source.
+ * It is called by download scheduler, so the same source is downloaded only once.
+ * @param downloadedRequest downloaded request
+ * @param request request of the same source with other target
+ * @return true if target is replaced by downloaded files
+ */
+bool DownloaderHandler::Place(DownloadRequest const & downloadedRequest, DownloadRequest const & request)
+{
+  // Specifications are only read, but components files can be changed by their install scripts
+  bool const isHardlinkAllowed = !request.pathPostfix.empty();
+  return componentUtils::FileUtils::ReplaceDirectory(
+      downloadedRequest.downloadPath, request.downloadPath, isHardlinkAllowed);
+}
+
+/**
+ * @brief Download url and compare checksum of downloaded files with expected one
+ * @param downloader downloader of url
+ * @param downloadPath staging directory where files are downloaded, it is removed by caller
+ * @param url url to download
+ * @param request download request with path postfix and expected checksum
+ * @return Downloaded status if files are downloaded and their checksum is expected,
+ * permanent failure if source isn't found or checksums differ
+ */
+DownloadStatus DownloaderHandler::DownloadVerified(
+    Downloader & downloader,
+    std::string const & downloadPath,
+    std::string const & url,
+    DownloadRequest const & request)
+{
+  std::string checksum;
+  DownloadStatus const status = request.checksum.empty()
+                                    ? downloader.Download(downloadPath, url, request.pathPostfix)
+                                    : downloader.DownloadWithChecksum(downloadPath, url, request.pathPostfix, checksum);
+  if (status != DownloadStatus::Downloaded)
+    return status;
+
+  if (!request.checksum.empty() && checksum != request.checksum)
+  {
+    SC_LOG_ERROR(
+        "Checksum of \"" + request.url + "\" is " + checksum + ", but " + request.checksum +
+        " is expected. Downloaded files aren't placed");
+    return DownloadStatus::FailedPermanently;
+  }
+
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Check if request is downloaded as stream of tar.gz archive.
+ * Whole GitHub repositories are downloaded as archives, so git
+ * history isn't transferred, single files are taken by their downloaders.
+ * @param request download request
+ * @return true if archive downloader is used for request
+ */
+bool DownloaderHandler::IsArchiveRequest(DownloadRequest const & request)
+{
+  if (request.urlClassAddr == keynodes::ScComponentManagerKeynodes::concept_http_url)
+    return DownloaderTarball::IsArchiveUrl(request.url);
+
+  return request.urlClassAddr == keynodes::ScComponentManagerKeynodes::concept_github_url &&
+         request.pathPostfix.empty() && request.url.rfind(GitHubConstants::GITHUB_PREFIX, 0) == 0;
+}
+
+/**
+ * @brief Get current revision of requested source
+ * @param request download request
+ * @return Revision identifier, return empty string if revision is unknown
+ */
+std::string DownloaderHandler::GetRevision(DownloadRequest const & request)
+{
+  if (!GetLocalUrl(request.url).empty())
+    return "";
+
+  Downloader * downloader = GetDownloader(request.urlClassAddr);
+  if (downloader == nullptr)
+    return "";
+
+  return downloader->GetRevision(request.url);
+}
+
+/**
+ * @brief Get checksum of local directory or mirror of source without copying it.
+ * Local sources have no revision, so they are compared by their content.
+ * @param request download request of source
+ * @return Checksum of local source, return empty string if source is remote or doesn't exist
+ */
+std::string DownloaderHandler::GetLocalChecksum(DownloadRequest const & request) const
+{
+  std::string sourcePath = DownloaderLocal::GetLocalPath(GetLocalUrl(request.url));
+  if (sourcePath.empty())
+    return "";
+
+  if (!request.pathPostfix.empty())
+    sourcePath += SpecificationConstants::DIRECTORY_DELIMETR + request.pathPostfix;
+
+  return componentUtils::ContentDigest::GetPathHash(sourcePath);
+}
+
+/**
+ * @brief Update downloaded source in place by changes since downloaded revision.
+ * Sources with expected checksum aren't updated, because they are taken by their content.
+ * @param request download request of source
+ * @param revision revision of source in download directory
+ * @param currentRevision revision that source is updated to
+ * @param changedPaths paths of added and changed files relative to download directory
+ * @return false if source can't be updated by changes, then it has to be downloaded again
+ */
+bool DownloaderHandler::DownloadChanges(
+    DownloadRequest const & request,
+    std::string const & revision,
+    std::string & currentRevision,
+    std::vector<std::string> & changedPaths)
+{
+  if (!IsUpdatable(request, revision))
+    return false;
+
+  Downloader * downloader = GetDownloader(request.urlClassAddr);
+  if (downloader == nullptr)
+    return false;
+
+  return downloader->DownloadChanges(request.downloadPath, request.url, revision, currentRevision, changedPaths);
+}
+
+/**
+ * @brief Find what download of request would do without downloading anything.
+ * Only git sources are updated by their changes.
+ * @param request download request of source
+ * @param revision revision of source in download directory, it is empty if source isn't downloaded
+ * @return Expected download action
+ */
+DownloadAction DownloaderHandler::GetDownloadAction(DownloadRequest const & request, std::string const & revision)
+    const
+{
+  if (!GetLocalUrl(request.url).empty())
+    return DownloadAction::Copy;
+
+  if (!request.checksum.empty())
+    return m_cache.Contains(DownloadCache::GetContentKey(request.checksum, request.pathPostfix))
+               ? DownloadAction::Cached
+               : DownloadAction::Fetch;
+
+  if (IsUpdatable(request, revision) &&
+      request.urlClassAddr == keynodes::ScComponentManagerKeynodes::concept_github_url)
+    return DownloadAction::Update;
+
+  // Revision of source is unknown without network, so cache is checked by downloaded revision
+  std::string const & cachedRevision = request.revision.empty() ? revision : request.revision;
+  if (!cachedRevision.empty() &&
+      m_cache.Contains(DownloadCache::GetKey(request.url, cachedRevision, request.pathPostfix)))
+    return DownloadAction::Cached;
+
+  return DownloadAction::Fetch;
+}
+
+bool DownloaderHandler::IsUpdatable(DownloadRequest const & request, std::string const & revision) const
+{
+  return !revision.empty() && request.checksum.empty() && request.pathPostfix.empty() &&
+         GetLocalUrl(request.url).empty() && componentUtils::FileUtils::IsDirectory(request.downloadPath);
+}
+
+/**
+ * @brief Get url of local copy of source
+ * @param url url of source
+ * @return Url of local mirror if url is mirrored, url itself if it is local,
+ * return empty string if source is remote
+ */
+std::string DownloaderHandler::GetLocalUrl(std::string const & url) const
+{
+  std::string const mirrorUrl = componentUtils::UrlUtils::GetMirrorUrl(url, m_mirrorRoot, m_mirrorPrefixes);
+  if (!mirrorUrl.empty())
+    return mirrorUrl;
+
+  return DownloaderLocal::IsLocalUrl(url) ? url : "";
 }
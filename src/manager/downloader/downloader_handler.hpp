@@ -7,7 +7,10 @@
 #pragma once
 
 #include <string>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 
 extern "C"
 {
@@ -16,29 +19,142 @@ extern "C"
 
 #include "sc-memory/sc_scs_helper.hpp"
 
+#include "download_cache.hpp"
+#include "download_request.hpp"
+#include "download_scheduler.hpp"
 #include "downloader.hpp"
 #include "downloader_git.hpp"
 #include "downloader_google_drive.hpp"
+#include "downloader_http.hpp"
+#include "downloader_local.hpp"
+#include "downloader_tarball.hpp"
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
 #include "src/manager/commands/keynodes/ScComponentManagerKeynodes.hpp"
+#include "src/manager/sc_component_manager_settings.hpp"
+#include "src/manager/utils/mirror_statistics.hpp"
+#include "src/manager/utils/process_runner.hpp"
+
+/**
+ * @brief Work that download of request would do, it is found without network.
+ */
+enum class DownloadAction
+{
+  // Source is copied from local directory or mirror
+  Copy,
+  // Source is taken from downloads cache
+  Cached,
+  // Downloaded source is updated by its changes
+  Update,
+  // Source is downloaded
+  Fetch
+};
 
 class DownloaderHandler
 {
 public:
-  explicit DownloaderHandler(std::string specificationsPath)
+  explicit DownloaderHandler(
+      std::string specificationsPath,
+      ScComponentManagerSettings const & settings = {},
+      std::shared_ptr<componentUtils::ProcessRunner> processRunner = std::make_shared<componentUtils::ProcessRunner>())
     : m_downloadDir(std::move(specificationsPath))
+    , m_processRunner(std::move(processRunner))
+    , m_gitTimeout(settings.gitTimeout)
+    , m_mirrorRoot(settings.mirrorRoot)
+    , m_mirrorPrefixes(settings.mirrorPrefixes)
+    , m_alternativeStaggerDelay(settings.alternativeStaggerDelay)
+    , m_cache(m_downloadDir + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::CACHE_DIRECTORY)
+    , m_mirrorStatistics(
+          m_downloadDir + SpecificationConstants::DIRECTORY_DELIMETR + SpecificationConstants::MIRRORS_FILENAME)
+    , m_scheduler(std::make_unique<DownloadScheduler>(
+          [this](DownloadRequest const & request) {
+            return Fetch(request);
+          },
+          settings,
+          &DownloaderHandler::Place))
   {
+    m_mirrorStatistics.Load();
   }
 
   ~DownloaderHandler();
 
-  void Download(ScMemoryContext * context, ScAddr const & nodeAddr);
+  bool Download(ScMemoryContext * context, ScAddr const & nodeAddr);
+
+  std::vector<DownloadRequest> GetDownloadRequests(ScMemoryContext * context, ScAddr const & nodeAddr);
+
+  bool GetRepositoryIndexRequest(ScMemoryContext * context, ScAddr const & repositoryAddr, DownloadRequest & request);
+
+  std::shared_future<DownloadResult> Submit(DownloadRequest const & request);
+
+  bool Download(DownloadRequest const & request);
+
+  DownloadResult DownloadAlternatives(std::vector<DownloadRequest> const & requests);
+
+  std::string GetRevision(DownloadRequest const & request);
+
+  std::string GetLocalChecksum(DownloadRequest const & request) const;
+
+  bool DownloadChanges(
+      DownloadRequest const & request,
+      std::string const & revision,
+      std::string & currentRevision,
+      std::vector<std::string> & changedPaths);
+
+  DownloadAction GetDownloadAction(DownloadRequest const & request, std::string const & revision) const;
+
+  DownloadStatistics GetStatistics() const;
 
 protected:
   std::string m_downloadDir;
   static char const DIRECTORY_DELIMITER = '/';
-  std::map<ScAddr, Downloader *, ScAddrLessFunc> m_downloaders = {
-      {keynodes::ScComponentManagerKeynodes::concept_github_url, new DownloaderGit()},
-      {keynodes::ScComponentManagerKeynodes::concept_google_drive_url, new DownloaderGoogleDrive()}};
+  std::shared_ptr<componentUtils::ProcessRunner> m_processRunner;
+  std::chrono::seconds m_gitTimeout;
+  std::string m_mirrorRoot;
+  std::vector<std::string> m_mirrorPrefixes;
+  std::chrono::milliseconds m_alternativeStaggerDelay;
+  DownloadCache m_cache;
+  componentUtils::MirrorStatistics m_mirrorStatistics;
+  std::once_flag m_downloadersInitialized;
+  std::map<ScAddr, Downloader *, ScAddrLessFunc> m_downloaders;
+  std::unique_ptr<DownloaderTarball> m_tarballDownloader;
+  DownloaderLocal m_localDownloader;
+  std::unique_ptr<DownloadScheduler> m_scheduler;
+
+  // Alternatives that were still downloaded when race was won by other alternative
+  struct AbandonedAlternative
+  {
+    std::shared_future<DownloadResult> result;
+    std::string path;
+  };
+  std::list<AbandonedAlternative> m_abandonedAlternatives;
+  std::mutex m_abandonedAlternativesMutex;
+
+  void CollectAbandonedAlternatives(bool isWaited);
+
+  void InitDownloaders();
+  Downloader * GetDownloader(ScAddr const & urlClassAddr);
+
+  DownloadAttempt Fetch(DownloadRequest const & request);
+
+  static bool Place(DownloadRequest const & downloadedRequest, DownloadRequest const & request);
+
+  DownloadStatus DownloadStaged(
+      Downloader & downloader,
+      std::string const & url,
+      DownloadRequest const & request,
+      std::string const & key,
+      size_t & bytesCount);
+
+  static DownloadStatus DownloadVerified(
+      Downloader & downloader,
+      std::string const & downloadPath,
+      std::string const & url,
+      DownloadRequest const & request);
+
+  static bool IsArchiveRequest(DownloadRequest const & request);
+
+  std::string GetLocalUrl(std::string const & url) const;
+
+  bool IsUpdatable(DownloadRequest const & request, std::string const & revision) const;
 
   ScAddr getDownloadableClass(ScMemoryContext * context, ScAddr const & nodeAddr);
   ScAddr getUrlLinkClass(ScMemoryContext * context, ScAddr const & linkAddr);
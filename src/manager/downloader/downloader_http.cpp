@@ -0,0 +1,234 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "downloader_http.hpp"
+
+#include <cstdio>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+
+DownloaderHttp::DownloaderHttp()
+{
+  static std::once_flag curlInitialized;
+  std::call_once(curlInitialized, []() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+  });
+
+  m_share = curl_share_init();
+  curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, &DownloaderHttp::LockShare);
+  curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, &DownloaderHttp::UnlockShare);
+  curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+  curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+DownloaderHttp::~DownloaderHttp()
+{
+  // Handles use share, so they are cleaned up first
+  for (CURL * curl : m_idleHandles)
+    curl_easy_cleanup(curl);
+  curl_share_cleanup(m_share);
+}
+
+/**
+ * @brief Download file
+ * @param downloadPath directory where file is placed
+ * @param urlAddress url of file or of directory with file
+ * @param pathPostfix path of file relative to urlAddress, url is file url if it is empty
+ * @return Status of download, see DownloadWithChecksum
+ */
+DownloadStatus DownloaderHttp::Download(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix)
+{
+  std::string checksum;
+  return DownloadWithChecksum(downloadPath, urlAddress, pathPostfix, checksum);
+}
+
+/**
+ * @brief Download file and hash it while it is received
+ * @param downloadPath directory where file is placed
+ * @param urlAddress url of file or of directory with file
+ * @param pathPostfix path of file relative to urlAddress, url is file url if it is empty
+ * @param checksum SHA-256 of downloaded file
+ * @return Downloaded status if file is downloaded, permanent failure if
+ * server rejects request, e.g. file isn't found
+ */
+DownloadStatus DownloaderHttp::DownloadWithChecksum(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix,
+    std::string & checksum)
+{
+  std::string const fileUrl = GetFileUrl(urlAddress, pathPostfix);
+  std::string const filename = pathPostfix.empty() ? fileUrl.substr(fileUrl.rfind('/') + 1) : pathPostfix;
+  std::string const filePath = downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + filename;
+  std::string const fileDirectory = filePath.substr(0, filePath.rfind(SpecificationConstants::DIRECTORY_DELIMETR));
+  if (filename.empty() || !sc_fs_mkdirs(fileDirectory.c_str()))
+  {
+    SC_LOG_ERROR("Can't download. Can't create file for \"" + fileUrl + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  // File is written next to target and renamed after download, so failed download doesn't leave partial file
+  std::string const partialFilePath = filePath + ".part";
+  FileWriter writer;
+  writer.file = fopen(partialFilePath.c_str(), "wb");
+  if (writer.file == nullptr)
+  {
+    SC_LOG_ERROR("Can't download. Can't create file for \"" + fileUrl + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  CURL * curl = AcquireHandle(fileUrl);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &DownloaderHttp::WriteData);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writer);
+
+  CURLcode const code = curl_easy_perform(curl);
+  long connectionsCount = 0;
+  curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &connectionsCount);
+  bool const isPermanentError = IsPermanentError(curl, code);
+  ReleaseHandle(curl);
+
+  bool const isWritten = fclose(writer.file) == 0;
+  if (code != CURLE_OK || !isWritten || std::rename(partialFilePath.c_str(), filePath.c_str()) != 0)
+  {
+    std::remove(partialFilePath.c_str());
+    SC_LOG_ERROR("Can't download \"" + fileUrl + "\": " + curl_easy_strerror(code));
+    return isPermanentError ? DownloadStatus::FailedPermanently : DownloadStatus::Failed;
+  }
+
+  checksum = writer.hasher.GetHash();
+  SC_LOG_DEBUG(
+      "DownloaderHttp: \"" + fileUrl + "\" is downloaded, " +
+      (connectionsCount == 0 ? "connection is reused" : "new connection is opened"));
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Get url of file. Files of GitHub repositories are
+ * downloaded from raw.githubusercontent.com.
+ * @param urlAddress url of file or of directory with file
+ * @param pathPostfix path of file relative to urlAddress
+ * @return Url of file
+ */
+std::string DownloaderHttp::GetFileUrl(std::string const & urlAddress, std::string const & pathPostfix)
+{
+  std::string const GITHUB_RAW_PREFIX = "https://raw.githubusercontent.com/";
+  std::string const GITHUB_DEFAULT_BRANCH = "HEAD";
+
+  std::string fileUrl = urlAddress;
+  while (!fileUrl.empty() && fileUrl.back() == '/')
+    fileUrl.pop_back();
+
+  if (pathPostfix.empty())
+    return fileUrl;
+
+  if (fileUrl.rfind(GitHubConstants::GITHUB_PREFIX, 0) == 0)
+  {
+    std::string const GIT_POSTFIX = ".git";
+    if (fileUrl.size() > GIT_POSTFIX.size() &&
+        fileUrl.compare(fileUrl.size() - GIT_POSTFIX.size(), GIT_POSTFIX.size(), GIT_POSTFIX) == 0)
+      fileUrl.erase(fileUrl.size() - GIT_POSTFIX.size());
+
+    fileUrl = GITHUB_RAW_PREFIX + fileUrl.substr(GitHubConstants::GITHUB_PREFIX.size()) +
+              SpecificationConstants::DIRECTORY_DELIMETR + GITHUB_DEFAULT_BRANCH;
+  }
+
+  return fileUrl + SpecificationConstants::DIRECTORY_DELIMETR + pathPostfix;
+}
+
+/**
+ * @brief Take transfer handle that isn't used by other threads. Idle handle is reused,
+ * so its kept alive connections are reused too, otherwise new handle is created.
+ * @param url url of transfer
+ * @return Curl handle, it must be returned by ReleaseHandle
+ */
+CURL * DownloaderHttp::AcquireHandle(std::string const & url)
+{
+  CURL * curl = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_idleHandlesMutex);
+    if (!m_idleHandles.empty())
+    {
+      curl = m_idleHandles.back();
+      m_idleHandles.pop_back();
+    }
+  }
+
+  // Reset doesn't close connections of handle, only its options are cleared
+  if (curl == nullptr)
+    curl = curl_easy_init();
+  else
+    curl_easy_reset(curl);
+
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl, CURLOPT_SHARE, m_share);
+  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
+  // Stalled transfer is aborted, so scheduler can retry it
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 60L);
+  curl_easy_setopt(curl, CURLOPT_USERAGENT, "sc-component-manager");
+  return curl;
+}
+
+/**
+ * @brief Check if failed transfer fails again if it is retried. Client errors,
+ * e.g. 404, are permanent, except request timeout and rate limit responses.
+ * @param curl handle of finished transfer
+ * @param code result of transfer
+ * @return true if transfer mustn't be retried
+ */
+bool DownloaderHttp::IsPermanentError(CURL * curl, CURLcode code)
+{
+  long constexpr kRequestTimeoutCode = 408;
+  long constexpr kTooManyRequestsCode = 429;
+
+  if (code == CURLE_UNSUPPORTED_PROTOCOL || code == CURLE_URL_MALFORMAT || code == CURLE_FILE_COULDNT_READ_FILE)
+    return true;
+  if (code != CURLE_HTTP_RETURNED_ERROR)
+    return false;
+
+  long responseCode = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+  return responseCode >= 400 && responseCode < 500 && responseCode != kRequestTimeoutCode &&
+         responseCode != kTooManyRequestsCode;
+}
+
+void DownloaderHttp::ReleaseHandle(CURL * curl)
+{
+  std::lock_guard<std::mutex> lock(m_idleHandlesMutex);
+  m_idleHandles.push_back(curl);
+}
+
+void DownloaderHttp::LockShare(CURL *, curl_lock_data data, curl_lock_access, void * userData)
+{
+  static_cast<DownloaderHttp *>(userData)->m_shareMutexes[data].lock();
+}
+
+void DownloaderHttp::UnlockShare(CURL *, curl_lock_data data, void * userData)
+{
+  static_cast<DownloaderHttp *>(userData)->m_shareMutexes[data].unlock();
+}
+
+size_t DownloaderHttp::WriteData(char * data, size_t size, size_t count, void * userData)
+{
+  auto * writer = static_cast<FileWriter *>(userData);
+  writer->hasher.Update(data, size * count);
+  return fwrite(data, 1, size * count, writer->file);
+}
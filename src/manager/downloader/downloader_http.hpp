@@ -0,0 +1,68 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "downloader.hpp"
+#include "src/manager/utils/hasher.hpp"
+
+/**
+ * @brief Downloads single files over HTTP(S) without starting processes.
+ * DNS cache and TLS sessions are shared by all downloads. Connections can't be
+ * shared between threads, so each concurrent download takes its own transfer handle
+ * from pool, and the next downloads by that handle reuse its kept alive connections.
+ */
+class DownloaderHttp : public Downloader
+{
+public:
+  DownloaderHttp();
+
+  ~DownloaderHttp() override;
+
+  DownloadStatus Download(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix = "") override;
+
+  DownloadStatus DownloadWithChecksum(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      std::string & checksum) override;
+
+  static std::string GetFileUrl(std::string const & urlAddress, std::string const & pathPostfix);
+
+protected:
+  CURLSH * m_share;
+  std::mutex m_shareMutexes[CURL_LOCK_DATA_LAST];
+
+  // Transfer handles that aren't used now, each keeps its own connections
+  std::vector<CURL *> m_idleHandles;
+  std::mutex m_idleHandlesMutex;
+
+  CURL * AcquireHandle(std::string const & url);
+
+  void ReleaseHandle(CURL * curl);
+
+  static bool IsPermanentError(CURL * curl, CURLcode code);
+
+  static void LockShare(CURL * handle, curl_lock_data data, curl_lock_access access, void * userData);
+  static void UnlockShare(CURL * handle, curl_lock_data data, void * userData);
+  // Destination of received data
+  struct FileWriter
+  {
+    FILE * file;
+    componentUtils::Hasher hasher;
+  };
+
+  static size_t WriteData(char * data, size_t size, size_t count, void * userData);
+};
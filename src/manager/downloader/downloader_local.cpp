@@ -0,0 +1,201 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "downloader_local.hpp"
+
+#include <dirent.h>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+#include "src/manager/utils/file_utils.hpp"
+
+/**
+ * @brief Copy local source into directory
+ * @param downloadPath directory where source is placed
+ * @param urlAddress `file://` url or absolute path of source
+ * @param pathPostfix path in source, the whole source is copied if it is empty
+ * @return Downloaded status if source is copied, permanent failure if source isn't found
+ */
+DownloadStatus DownloaderLocal::Download(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix)
+{
+  return Copy(downloadPath, urlAddress, pathPostfix, nullptr);
+}
+
+/**
+ * @brief Copy local source into directory and hash its files while they are copied.
+ * Files are copied through user space then, but they aren't read again to get checksum.
+ * @param downloadPath directory where source is placed
+ * @param urlAddress `file://` url or absolute path of source
+ * @param pathPostfix path in source, the whole source is copied if it is empty
+ * @param checksum checksum of copied source, see componentUtils::ContentDigest
+ * @return Status of copying, see Download
+ */
+DownloadStatus DownloaderLocal::DownloadWithChecksum(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix,
+    std::string & checksum)
+{
+  componentUtils::ContentDigest digest;
+  DownloadStatus const status = Copy(downloadPath, urlAddress, pathPostfix, &digest);
+  if (status == DownloadStatus::Downloaded)
+    checksum = digest.GetHash();
+  return status;
+}
+
+DownloadStatus DownloaderLocal::Copy(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix,
+    componentUtils::ContentDigest * digest)
+{
+  std::string sourcePath = GetLocalPath(urlAddress);
+  if (sourcePath.empty())
+  {
+    SC_LOG_ERROR("Can't copy. \"" + urlAddress + "\" isn't local path");
+    return DownloadStatus::FailedPermanently;
+  }
+
+  if (!pathPostfix.empty())
+    sourcePath += SpecificationConstants::DIRECTORY_DELIMETR + pathPostfix;
+
+  // Specifications are only read, but components files can be changed by their install scripts
+  bool const isHardlinkAllowed = !pathPostfix.empty();
+  if (componentUtils::FileUtils::IsDirectory(sourcePath))
+  {
+    bool const isCopied = digest == nullptr
+                              ? componentUtils::FileUtils::CopyDirectory(sourcePath, downloadPath, isHardlinkAllowed)
+                              : CopyHashedDirectory(sourcePath, downloadPath, "", *digest);
+    if (!isCopied)
+    {
+      SC_LOG_ERROR("Can't copy \"" + sourcePath + "\" into \"" + downloadPath + "\"");
+      return DownloadStatus::Failed;
+    }
+    return DownloadStatus::Downloaded;
+  }
+
+  if (!sc_fs_isfile(sourcePath.c_str()))
+  {
+    SC_LOG_ERROR("Can't copy. \"" + sourcePath + "\" not found");
+    return DownloadStatus::FailedPermanently;
+  }
+
+  // Checksum of single file is its hash, see componentUtils::ContentDigest
+  std::string const fileName = sourcePath.substr(sourcePath.rfind('/') + 1);
+  std::string const targetPath = downloadPath + SpecificationConstants::DIRECTORY_DELIMETR + fileName;
+  std::string fileHash;
+  bool const isCopied = sc_fs_mkdirs(downloadPath.c_str()) &&
+                        (digest == nullptr
+                             ? componentUtils::FileUtils::CopyFile(sourcePath, targetPath, isHardlinkAllowed)
+                             : componentUtils::FileUtils::CopyHashedFile(sourcePath, targetPath, fileHash));
+  if (!isCopied)
+  {
+    SC_LOG_ERROR("Can't copy \"" + sourcePath + "\" into \"" + downloadPath + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  if (digest != nullptr)
+  {
+    *digest = componentUtils::ContentDigest(fileName);
+    digest->AddFile(fileName, fileHash);
+  }
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Copy regular files of directory recursively and add their hashes to digest
+ * @param sourcePath path to existing directory
+ * @param targetPath path to target directory, it is created if it doesn't exist
+ * @param relativePath path of directory relative to copied source
+ * @param digest digest of copied source
+ * @return true if all files are copied
+ */
+bool DownloaderLocal::CopyHashedDirectory(
+    std::string const & sourcePath,
+    std::string const & targetPath,
+    std::string const & relativePath,
+    componentUtils::ContentDigest & digest)
+{
+  DIR * directory = opendir(sourcePath.c_str());
+  if (directory == nullptr || !sc_fs_mkdirs(targetPath.c_str()))
+  {
+    if (directory != nullptr)
+      closedir(directory);
+    return false;
+  }
+
+  bool result = true;
+  struct dirent * entry;
+  while ((entry = readdir(directory)) != nullptr)
+  {
+    std::string const name = entry->d_name;
+    if (name == "." || name == "..")
+      continue;
+
+    std::string const sourceEntryPath = sourcePath + SpecificationConstants::DIRECTORY_DELIMETR + name;
+    std::string const targetEntryPath = targetPath + SpecificationConstants::DIRECTORY_DELIMETR + name;
+    std::string const entryRelativePath =
+        relativePath.empty() ? name : relativePath + SpecificationConstants::DIRECTORY_DELIMETR + name;
+    if (componentUtils::FileUtils::IsDirectory(sourceEntryPath))
+    {
+      result = CopyHashedDirectory(sourceEntryPath, targetEntryPath, entryRelativePath, digest) && result;
+      continue;
+    }
+
+    std::string fileHash;
+    if (componentUtils::FileUtils::CopyHashedFile(sourceEntryPath, targetEntryPath, fileHash))
+      digest.AddFile(entryRelativePath, fileHash);
+    else
+      result = false;
+  }
+  closedir(directory);
+
+  return result;
+}
+
+/**
+ * @brief Get path of local source
+ * @param urlAddress `file://` url or absolute path
+ * @return Absolute path without trailing delimiters,
+ * return empty string if url isn't local
+ */
+std::string DownloaderLocal::GetLocalPath(std::string const & urlAddress)
+{
+  std::string const FILE_SCHEME = "file://";
+
+  std::string path;
+  if (urlAddress.rfind(FILE_SCHEME, 0) == 0)
+    path = urlAddress.substr(FILE_SCHEME.size());
+  else if (urlAddress.rfind('/', 0) == 0)
+    path = urlAddress;
+
+  if (path.rfind('/', 0) != 0)
+    return "";
+
+  while (path.size() > 1 && path.back() == '/')
+    path.pop_back();
+
+  return path;
+}
+
+/**
+ * @brief Check if source is placed in local file system
+ * @param urlAddress url of source
+ * @return true if url is `file://` url or absolute path
+ */
+bool DownloaderLocal::IsLocalUrl(std::string const & urlAddress)
+{
+  return !GetLocalPath(urlAddress).empty();
+}
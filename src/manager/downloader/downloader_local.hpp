@@ -0,0 +1,49 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+
+#include "downloader.hpp"
+
+/**
+ * @brief Copies sources from local file system: `file://` urls and
+ * directories of local mirror. Files are copied by reflinks or
+ * copy_file_range, so data isn't passed through user space, unless
+ * checksum is requested, then files are hashed while they are copied.
+ */
+class DownloaderLocal : public Downloader
+{
+public:
+  DownloadStatus Download(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix = "") override;
+
+  DownloadStatus DownloadWithChecksum(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      std::string & checksum) override;
+
+  static std::string GetLocalPath(std::string const & urlAddress);
+
+  static bool IsLocalUrl(std::string const & urlAddress);
+
+protected:
+  static DownloadStatus Copy(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      componentUtils::ContentDigest * digest);
+
+  static bool CopyHashedDirectory(
+      std::string const & sourcePath,
+      std::string const & targetPath,
+      std::string const & relativePath,
+      componentUtils::ContentDigest & digest);
+};
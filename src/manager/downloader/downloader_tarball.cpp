@@ -0,0 +1,128 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "downloader_tarball.hpp"
+
+#include "sc-memory/sc_debug.hpp"
+
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
+#include "src/manager/utils/tar_extractor.hpp"
+
+/**
+ * @brief Download archive and extract requested path of it
+ * @param downloadPath directory where requested path is placed
+ * @param urlAddress url of archive or of GitHub repository
+ * @param pathPostfix path in archive, the whole archive is extracted if it is empty
+ * @return Status of download, see DownloadWithChecksum
+ */
+DownloadStatus DownloaderTarball::Download(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix)
+{
+  std::string checksum;
+  return DownloadWithChecksum(downloadPath, urlAddress, pathPostfix, checksum);
+}
+
+/**
+ * @brief Download archive, extract requested path of it and hash extracted files
+ * @param downloadPath directory where requested path is placed
+ * @param urlAddress url of archive or of GitHub repository
+ * @param pathPostfix path in archive, the whole archive is extracted if it is empty
+ * @param checksum checksum of extracted files, see componentUtils::ContentDigest
+ * @return Downloaded status if archive is received completely and requested path is extracted,
+ * permanent failure if archive or requested path isn't found
+ */
+DownloadStatus DownloaderTarball::DownloadWithChecksum(
+    std::string const & downloadPath,
+    std::string const & urlAddress,
+    std::string const & pathPostfix,
+    std::string & checksum)
+{
+  std::string const archiveUrl = GetArchiveUrl(urlAddress);
+  componentUtils::TarExtractor extractor(downloadPath, pathPostfix);
+
+  CURL * curl = AcquireHandle(archiveUrl);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &DownloaderTarball::WriteArchiveData);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &extractor);
+
+  CURLcode const code = curl_easy_perform(curl);
+  bool const isPermanentError = IsPermanentError(curl, code);
+  ReleaseHandle(curl);
+
+  if (code != CURLE_OK)
+  {
+    SC_LOG_ERROR("Can't download \"" + archiveUrl + "\": " + curl_easy_strerror(code));
+    return isPermanentError ? DownloadStatus::FailedPermanently : DownloadStatus::Failed;
+  }
+
+  if (!extractor.Finish())
+  {
+    SC_LOG_ERROR("Can't extract \"" + archiveUrl + "\"");
+    return DownloadStatus::Failed;
+  }
+
+  if (extractor.GetFilesCount() == 0)
+  {
+    SC_LOG_ERROR("Can't download. \"" + pathPostfix + "\" isn't found in \"" + archiveUrl + "\"");
+    return DownloadStatus::FailedPermanently;
+  }
+
+  checksum = extractor.GetContentHash();
+  SC_LOG_DEBUG(
+      "DownloaderTarball: " + std::to_string(extractor.GetFilesCount()) + " files, " +
+      std::to_string(extractor.GetBytesCount()) + " bytes are extracted from \"" + archiveUrl + "\"");
+  return DownloadStatus::Downloaded;
+}
+
+/**
+ * @brief Get url of source archive
+ * @param urlAddress url of archive or of GitHub repository
+ * @param revision revision of GitHub repository, default branch is used if it is empty
+ * @return Url of tar.gz archive
+ */
+std::string DownloaderTarball::GetArchiveUrl(std::string const & urlAddress, std::string const & revision)
+{
+  std::string const GITHUB_ARCHIVE_PREFIX = "https://codeload.github.com/";
+  std::string const GITHUB_ARCHIVE_INFIX = "/tar.gz/";
+  std::string const DEFAULT_REVISION = "HEAD";
+  std::string const GIT_POSTFIX = ".git";
+
+  if (urlAddress.rfind(GitHubConstants::GITHUB_PREFIX, 0) != 0)
+    return urlAddress;
+
+  std::string repository = urlAddress.substr(GitHubConstants::GITHUB_PREFIX.size());
+  while (!repository.empty() && repository.back() == '/')
+    repository.pop_back();
+  if (repository.size() > GIT_POSTFIX.size() &&
+      repository.compare(repository.size() - GIT_POSTFIX.size(), GIT_POSTFIX.size(), GIT_POSTFIX) == 0)
+    repository.erase(repository.size() - GIT_POSTFIX.size());
+
+  return GITHUB_ARCHIVE_PREFIX + repository + GITHUB_ARCHIVE_INFIX + (revision.empty() ? DEFAULT_REVISION : revision);
+}
+
+/**
+ * @brief Check if url refers to tar.gz archive
+ * @param urlAddress url
+ * @return true if url ends with .tar.gz or .tgz
+ */
+bool DownloaderTarball::IsArchiveUrl(std::string const & urlAddress)
+{
+  std::string const url = urlAddress.substr(0, urlAddress.find_first_of("?#"));
+  for (std::string const & postfix : {std::string(".tar.gz"), std::string(".tgz")})
+  {
+    if (url.size() > postfix.size() && url.compare(url.size() - postfix.size(), postfix.size(), postfix) == 0)
+      return true;
+  }
+  return false;
+}
+
+size_t DownloaderTarball::WriteArchiveData(char * data, size_t size, size_t count, void * userData)
+{
+  // Returned size that differs from received size aborts transfer
+  auto * extractor = static_cast<componentUtils::TarExtractor *>(userData);
+  return extractor->Write(data, size * count) ? size * count : 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+
+#include "downloader_http.hpp"
+
+/**
+ * @brief Downloads tar.gz archive of source and extracts requested path
+ * while archive is being received. Archive isn't saved on disk.
+ * GitHub repositories are downloaded as archives of requested revision.
+ */
+class DownloaderTarball : public DownloaderHttp
+{
+public:
+  DownloadStatus Download(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix = "") override;
+
+  DownloadStatus DownloadWithChecksum(
+      std::string const & downloadPath,
+      std::string const & urlAddress,
+      std::string const & pathPostfix,
+      std::string & checksum) override;
+
+  static std::string GetArchiveUrl(std::string const & urlAddress, std::string const & revision = "");
+
+  static bool IsArchiveUrl(std::string const & urlAddress);
+
+protected:
+  static size_t WriteArchiveData(char * data, size_t size, size_t count, void * userData);
+};
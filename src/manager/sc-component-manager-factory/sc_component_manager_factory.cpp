@@ -7,15 +7,115 @@
 #include "sc_component_manager_factory.hpp"
 #include "src/manager/sc_component_manager_impl.hpp"
 
+/**
+ * @brief Get numeric parameter from config
+ * @param params sc-component-manager config params
+ * @param key name of parameter
+ * @param defaultValue value that is used if parameter isn't set or is invalid
+ * @param minValue the least valid value of parameter
+ * @return Value of parameter
+ */
+size_t ScComponentManagerFactory::GetCountParameter(
+    ScParams const & params,
+    std::string const & key,
+    size_t const defaultValue,
+    size_t const minValue)
+{
+  if (!params.count(key))
+    return defaultValue;
+
+  try
+  {
+    std::string const & valueString = params.at(key);
+    size_t const value = std::stoul(valueString);
+    if (value >= minValue && valueString.find('-') == std::string::npos)
+      return value;
+  }
+  catch (std::exception const &)
+  {
+  }
+
+  SC_LOG_WARNING("ScComponentManagerFactory: Invalid value of \"" + key + "\", default is used.");
+  return defaultValue;
+}
+
+/**
+ * @brief Get list parameter from config, items are separated by ';'
+ * @param params sc-component-manager config params
+ * @param key name of parameter
+ * @return Non-empty items of parameter, return empty vector if parameter isn't set
+ */
+std::vector<std::string> ScComponentManagerFactory::GetListParameter(ScParams const & params, std::string const & key)
+{
+  std::vector<std::string> items;
+  if (!params.count(key))
+    return items;
+
+  std::string const & valueString = params.at(key);
+  size_t itemBegin = 0;
+  while (itemBegin <= valueString.size())
+  {
+    size_t itemEnd = valueString.find(';', itemBegin);
+    if (itemEnd == std::string::npos)
+      itemEnd = valueString.size();
+
+    std::string const item = valueString.substr(itemBegin, itemEnd - itemBegin);
+    size_t const trimBegin = item.find_first_not_of(" \t");
+    if (trimBegin != std::string::npos)
+      items.push_back(item.substr(trimBegin, item.find_last_not_of(" \t") - trimBegin + 1));
+
+    itemBegin = itemEnd + 1;
+  }
+
+  return items;
+}
+
 std::unique_ptr<ScComponentManager> ScComponentManagerFactory::ConfigureScComponentManager(
     ScParams const & scComponentManagerParams,
     sc_memory_params const & memoryParams)
 {
   std::string const SPECIFICATIONS_PATH = "specifications_path";
+  std::string const DOWNLOAD_THREADS = "download_threads";
+  std::string const PARSE_THREADS = "parse_threads";
+  std::string const HOST_CONNECTIONS = "host_connections";
+  std::string const DOWNLOAD_RETRIES = "download_retries";
+  std::string const DOWNLOAD_RETRY_DELAY = "download_retry_delay";
+  std::string const ALTERNATIVE_STAGGER_DELAY = "alternative_stagger_delay";
+  std::string const GIT_TIMEOUT = "git_timeout";
+  std::string const INSTALL_TIMEOUT = "install_timeout";
+  std::string const INSTALL_CPU_TIMEOUT = "install_cpu_timeout";
+  std::string const INSTALL_THREADS = "install_threads";
+  std::string const MIRROR_ROOT = "mirror_root";
+  std::string const MIRROR_PREFIXES = "mirror_prefixes";
   try
   {
+    ScComponentManagerSettings settings;
+    settings.downloadThreadsCount =
+        GetCountParameter(scComponentManagerParams, DOWNLOAD_THREADS, settings.downloadThreadsCount);
+    settings.parseThreadsCount =
+        GetCountParameter(scComponentManagerParams, PARSE_THREADS, settings.parseThreadsCount);
+    settings.hostConnectionsLimit =
+        GetCountParameter(scComponentManagerParams, HOST_CONNECTIONS, settings.hostConnectionsLimit);
+    settings.downloadRetriesCount =
+        GetCountParameter(scComponentManagerParams, DOWNLOAD_RETRIES, settings.downloadRetriesCount, 0);
+    settings.downloadRetryDelay = std::chrono::milliseconds(GetCountParameter(
+        scComponentManagerParams, DOWNLOAD_RETRY_DELAY, settings.downloadRetryDelay.count(), 0));
+    settings.alternativeStaggerDelay = std::chrono::milliseconds(GetCountParameter(
+        scComponentManagerParams, ALTERNATIVE_STAGGER_DELAY, settings.alternativeStaggerDelay.count(), 0));
+    settings.gitTimeout = std::chrono::seconds(
+        GetCountParameter(scComponentManagerParams, GIT_TIMEOUT, settings.gitTimeout.count()));
+    settings.installTimeout = std::chrono::seconds(
+        GetCountParameter(scComponentManagerParams, INSTALL_TIMEOUT, settings.installTimeout.count(), 0));
+    settings.installCpuTimeout = std::chrono::seconds(
+        GetCountParameter(scComponentManagerParams, INSTALL_CPU_TIMEOUT, settings.installCpuTimeout.count(), 0));
+    settings.installThreadsCount =
+        GetCountParameter(scComponentManagerParams, INSTALL_THREADS, settings.installThreadsCount);
+    if (scComponentManagerParams.count(MIRROR_ROOT))
+      settings.mirrorRoot = scComponentManagerParams.at(MIRROR_ROOT);
+    settings.mirrorPrefixes = GetListParameter(scComponentManagerParams, MIRROR_PREFIXES);
+
     std::unique_ptr<ScComponentManager> scComponentManager = std::unique_ptr<ScComponentManager>(
-        new ScComponentManagerImpl(scComponentManagerParams.at(SPECIFICATIONS_PATH), memoryParams));
+        new ScComponentManagerImpl(scComponentManagerParams.at(SPECIFICATIONS_PATH), memoryParams, settings));
     return scComponentManager;
   }
   catch (utils::ScException const & exception)
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "src/manager/sc_component_manager.hpp"
 #include "sc_memory_config.hpp"
 
@@ -15,4 +18,13 @@ public:
   static std::unique_ptr<ScComponentManager> ConfigureScComponentManager(
       ScParams const & scComponentManagerParams,
       sc_memory_params const & memoryParams);
+
+protected:
+  static size_t GetCountParameter(
+      ScParams const & params,
+      std::string const & key,
+      size_t defaultValue,
+      size_t minValue = 1);
+
+  static std::vector<std::string> GetListParameter(ScParams const & params, std::string const & key);
 };
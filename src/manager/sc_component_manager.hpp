@@ -14,15 +14,19 @@
 #include "sc_memory_config.hpp"
 
 #include "commands/sc_component_manager_command_handler.hpp"
+#include "sc_component_manager_settings.hpp"
 
 class ScComponentManager
 {
 public:
-  explicit ScComponentManager(std::string specificationsPath, sc_memory_params memoryParams)
+  explicit ScComponentManager(
+      std::string specificationsPath,
+      sc_memory_params memoryParams,
+      ScComponentManagerSettings const & settings = {})
     : m_specificationsPath(std::move(specificationsPath))
   {
     ScMemory::Initialize(memoryParams);
-    m_handler = new ScComponentManagerCommandHandler(m_specificationsPath);
+    m_handler = new ScComponentManagerCommandHandler(m_specificationsPath, settings);
   }
 
   void QuietInstall();
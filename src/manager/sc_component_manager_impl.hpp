@@ -13,8 +13,11 @@
 class ScComponentManagerImpl : public ScComponentManager
 {
 public:
-  ScComponentManagerImpl(std::string specificationsPath, sc_memory_params memoryParams)
-    : ScComponentManager(std::move(specificationsPath), memoryParams)
+  ScComponentManagerImpl(
+      std::string specificationsPath,
+      sc_memory_params memoryParams,
+      ScComponentManagerSettings const & settings = {})
+    : ScComponentManager(std::move(specificationsPath), memoryParams, settings)
   {
     keynodes::ScComponentManagerKeynodes::InitGlobal();
   }
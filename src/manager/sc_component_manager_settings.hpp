@@ -0,0 +1,44 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tunable parameters of sc-component-manager read
+ * from `sc-component-manager` config group.
+ */
+struct ScComponentManagerSettings
+{
+  // Count of workers that download specifications during `components init`.
+  size_t downloadThreadsCount = 4;
+  // Count of workers that read and check downloaded specifications during `components init`.
+  size_t parseThreadsCount = 2;
+  // Count of simultaneous downloads from one host.
+  size_t hostConnectionsLimit = 4;
+  // Count of retries of failed download.
+  size_t downloadRetriesCount = 3;
+  // Delay before the first retry, it is doubled for each next retry.
+  std::chrono::milliseconds downloadRetryDelay{500};
+  // Delay before the next alternative address is started if the previous ones aren't downloaded yet.
+  std::chrono::milliseconds alternativeStaggerDelay{1000};
+  // Git commands are terminated if they run longer.
+  std::chrono::seconds gitTimeout{600};
+  // Install scripts are terminated if they run longer, zero means no limit.
+  std::chrono::seconds installTimeout{3600};
+  // Install scripts are killed if they use more CPU time, zero means no limit.
+  std::chrono::seconds installCpuTimeout{0};
+  // Count of workers that download and install components whose dependencies are installed.
+  size_t installThreadsCount = 4;
+  // Directory of local mirror, urls with mirrored prefixes are copied from it.
+  std::string mirrorRoot;
+  // Prefixes of urls that are rewritten to local mirror.
+  std::vector<std::string> mirrorPrefixes;
+};
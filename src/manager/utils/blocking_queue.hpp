@@ -0,0 +1,131 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+
+namespace componentUtils
+{
+
+struct QueueStatistics
+{
+  // The biggest count of items that were in queue at the same time
+  size_t maxDepth = 0;
+  // Count of pushes that waited for free place, producer is faster than consumer
+  size_t pushStallsCount = 0;
+  // Count of pops that waited for item, consumer is faster than producer
+  size_t popStallsCount = 0;
+
+  std::string ToString() const
+  {
+    return "max depth " + std::to_string(maxDepth) + ", producer stalls " + std::to_string(pushStallsCount) +
+           ", consumer stalls " + std::to_string(popStallsCount);
+  }
+};
+
+/**
+ * @brief Thread safe queue with bounded capacity. It connects stages
+ * of pipeline: push blocks while queue is full, pop blocks while
+ * queue is empty and isn't closed.
+ */
+template <class TItem>
+class BlockingQueue
+{
+public:
+  explicit BlockingQueue(size_t capacity)
+    : m_capacity(std::max<size_t>(capacity, 1))
+  {
+  }
+
+  /**
+   * @brief Add item to the end of queue
+   * @param item added item
+   * @return false if queue is closed, then item is dropped
+   */
+  bool Push(TItem item)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_items.size() >= m_capacity && !m_isClosed)
+    {
+      ++m_statistics.pushStallsCount;
+      m_itemPopped.wait(lock, [this]() {
+        return m_isClosed || m_items.size() < m_capacity;
+      });
+    }
+
+    if (m_isClosed)
+      return false;
+
+    m_items.push(std::move(item));
+    m_statistics.maxDepth = std::max(m_statistics.maxDepth, m_items.size());
+    lock.unlock();
+    m_itemPushed.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Take the first item from queue
+   * @param item taken item
+   * @return false if queue is closed and there are no more items
+   */
+  bool Pop(TItem & item)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_items.empty() && !m_isClosed)
+    {
+      ++m_statistics.popStallsCount;
+      m_itemPushed.wait(lock, [this]() {
+        return m_isClosed || !m_items.empty();
+      });
+    }
+
+    if (m_items.empty())
+      return false;
+
+    item = std::move(m_items.front());
+    m_items.pop();
+    lock.unlock();
+    m_itemPopped.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Wake up all consumers and producers. Pop returns false when queue becomes empty,
+   * the next items aren't pushed.
+   */
+  void Close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isClosed = true;
+    }
+    m_itemPushed.notify_all();
+    m_itemPopped.notify_all();
+  }
+
+  QueueStatistics GetStatistics() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+  }
+
+protected:
+  size_t const m_capacity;
+  std::queue<TItem> m_items;
+  bool m_isClosed = false;
+  QueueStatistics m_statistics;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_itemPushed;
+  std::condition_variable m_itemPopped;
+};
+
+}  // namespace componentUtils
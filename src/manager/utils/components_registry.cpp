@@ -0,0 +1,48 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "components_registry.hpp"
+
+namespace
+{
+// Url, revision, install time, hash and specification hash precede files
+size_t constexpr kFilesFieldIndex = 5;
+}  // namespace
+
+namespace componentUtils
+{
+
+ComponentsRegistry::ComponentsRegistry(std::string registryPath)
+  : PersistentStore(std::move(registryPath))
+{
+}
+
+bool ComponentsRegistry::ParseEntry(std::vector<std::string> const & fields, RegistryEntry & entry) const
+{
+  if (fields.size() < kFilesFieldIndex || !TabSeparatedFile::ParseValue(fields[2], entry.installTime))
+    return false;
+
+  entry.url = fields[0];
+  entry.revision = fields[1];
+  entry.hash = fields[3];
+  entry.specificationHash = fields[4];
+  entry.files.assign(fields.cbegin() + kFilesFieldIndex, fields.cend());
+  return true;
+}
+
+std::vector<std::string> ComponentsRegistry::FormatEntry(RegistryEntry const & entry) const
+{
+  std::vector<std::string> fields = {
+      entry.url,
+      entry.revision,
+      TabSeparatedFile::FormatValue(entry.installTime),
+      entry.hash,
+      entry.specificationHash};
+  fields.insert(fields.cend(), entry.files.cbegin(), entry.files.cend());
+  return fields;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,50 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "persistent_store.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Installed state of component.
+ */
+struct RegistryEntry
+{
+  std::string url;
+  std::string revision;
+  // Unix time of installation in seconds
+  int64_t installTime = 0;
+  // Checksum of downloaded source before install scripts are run
+  std::string hash;
+  // Hash of install scripts and files patterns of component specification
+  std::string specificationHash;
+  // Paths of component files after installation relative to component directory
+  std::vector<std::string> files;
+};
+
+/**
+ * @brief Persisted map from system identifier of installed component to its installed state.
+ * Files of component are saved as the last fields of its line. All methods are thread safe.
+ */
+class ComponentsRegistry : public PersistentStore<RegistryEntry>
+{
+public:
+  explicit ComponentsRegistry(std::string registryPath);
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, RegistryEntry & entry) const override;
+
+  std::vector<std::string> FormatEntry(RegistryEntry const & entry) const override;
+};
+
+}  // namespace componentUtils
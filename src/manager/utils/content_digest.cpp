@@ -0,0 +1,110 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "content_digest.hpp"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "hasher.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @param rootPath path of hashed source relative to paths of added files,
+ * paths of files are hashed relative to it
+ */
+ContentDigest::ContentDigest(std::string rootPath)
+  : m_rootPath(std::move(rootPath))
+{
+  while (!m_rootPath.empty() && m_rootPath.back() == '/')
+    m_rootPath.pop_back();
+}
+
+/**
+ * @brief Add hash of written file
+ * @param path path of file relative to download directory
+ * @param fileHash SHA-256 of file content
+ */
+void ContentDigest::AddFile(std::string const & path, std::string const & fileHash)
+{
+  m_fileHashes[path] = fileHash;
+}
+
+/**
+ * @brief Get checksum of added files
+ * @return Hash of file if root path is the only added file, hash of directory otherwise,
+ * return empty string if no files are added
+ */
+std::string ContentDigest::GetHash() const
+{
+  if (m_fileHashes.empty())
+    return "";
+
+  if (m_fileHashes.size() == 1 && m_fileHashes.cbegin()->first == m_rootPath)
+    return m_fileHashes.cbegin()->second;
+
+  size_t const prefixSize = m_rootPath.empty() ? 0 : m_rootPath.size() + 1;
+  Hasher hasher;
+  for (auto const & it : m_fileHashes)
+  {
+    std::string const line = it.second + "  " + it.first.substr(prefixSize) + "\n";
+    hasher.Update(line.data(), line.size());
+  }
+
+  return hasher.GetHash();
+}
+
+/**
+ * @brief Get checksum of downloaded file or directory by reading it.
+ * It is used by downloaders that can't hash data while it is written.
+ * @param path path of file or directory
+ * @return Checksum, return empty string if path doesn't exist
+ */
+std::string ContentDigest::GetPathHash(std::string const & path)
+{
+  struct stat pathStat = {};
+  if (stat(path.c_str(), &pathStat) != 0)
+    return "";
+
+  if (S_ISREG(pathStat.st_mode))
+    return Hasher::GetFileHash(path);
+
+  ContentDigest digest;
+  digest.AddDirectory(path, "");
+  return digest.GetHash();
+}
+
+void ContentDigest::AddDirectory(std::string const & directoryPath, std::string const & relativePath)
+{
+  DIR * directory = opendir(directoryPath.c_str());
+  if (directory == nullptr)
+    return;
+
+  struct dirent * entry;
+  while ((entry = readdir(directory)) != nullptr)
+  {
+    std::string const name = entry->d_name;
+    if (name == "." || name == "..")
+      continue;
+
+    std::string const entryPath = directoryPath + "/" + name;
+    std::string const entryRelativePath = relativePath.empty() ? name : relativePath + "/" + name;
+    struct stat entryStat = {};
+    if (lstat(entryPath.c_str(), &entryStat) != 0)
+      continue;
+
+    if (S_ISDIR(entryStat.st_mode))
+      AddDirectory(entryPath, entryRelativePath);
+    else if (S_ISREG(entryStat.st_mode))
+      AddFile(entryRelativePath, Hasher::GetFileHash(entryPath));
+  }
+
+  closedir(directory);
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,40 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Checksum of downloaded source. Checksum of single file is its SHA-256.
+ * Checksum of directory is SHA-256 of "<file hash>  <relative path>\n" lines of
+ * its regular files sorted by path, it is equal to output of
+ * `find . -type f -printf '%P\n' | LC_ALL=C sort | xargs -d '\n' sha256sum | sha256sum`.
+ * Hashes of files are added while files are written, so data isn't read again.
+ */
+class ContentDigest
+{
+public:
+  explicit ContentDigest(std::string rootPath = "");
+
+  void AddFile(std::string const & path, std::string const & fileHash);
+
+  std::string GetHash() const;
+
+  static std::string GetPathHash(std::string const & path);
+
+protected:
+  std::string m_rootPath;
+  std::map<std::string, std::string> m_fileHashes;
+
+  void AddDirectory(std::string const & directoryPath, std::string const & relativePath);
+};
+
+}  // namespace componentUtils
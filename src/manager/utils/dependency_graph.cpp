@@ -0,0 +1,170 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "dependency_graph.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Add component with its dependencies, repeated dependencies are kept once
+ * @param component system identifier of component
+ * @param dependencies system identifiers of components that should be installed before it
+ */
+void DependencyGraph::AddComponent(std::string const & component, std::vector<std::string> const & dependencies)
+{
+  std::vector<std::string> & componentDependencies = m_dependencies[component];
+  for (std::string const & dependency : dependencies)
+  {
+    if (std::find(componentDependencies.cbegin(), componentDependencies.cend(), dependency) ==
+        componentDependencies.cend())
+      componentDependencies.push_back(dependency);
+  }
+}
+
+bool DependencyGraph::Contains(std::string const & component) const
+{
+  return m_dependencies.find(component) != m_dependencies.cend();
+}
+
+std::vector<std::string> const & DependencyGraph::GetDependencies(std::string const & component) const
+{
+  static std::vector<std::string> const noDependencies;
+
+  auto const & it = m_dependencies.find(component);
+  return it == m_dependencies.cend() ? noDependencies : it->second;
+}
+
+/**
+ * @brief Make order in which each component goes once and after all its dependencies.
+ * Components are visited in depth first order, so order is stable for the same graph.
+ * @param components system identifiers of requested components
+ * @param order requested components with all their dependencies
+ * @param cycle components of found cycle, the first component is repeated at the end
+ * @return false if dependencies have cycle, then order is incomplete
+ */
+bool DependencyGraph::GetInstallOrder(
+    std::vector<std::string> const & components,
+    std::vector<std::string> & order,
+    std::vector<std::string> & cycle) const
+{
+  enum class State
+  {
+    Visiting,
+    Visited
+  };
+
+  order.clear();
+  cycle.clear();
+  std::unordered_map<std::string, State> states;
+  // Path from requested component with index of the next dependency of each component in it,
+  // it is explicit so deep graphs don't overflow call stack
+  std::vector<std::pair<std::string, size_t>> path;
+
+  for (std::string const & component : components)
+  {
+    if (states.find(component) != states.cend())
+      continue;
+
+    states[component] = State::Visiting;
+    path.emplace_back(component, 0);
+    while (!path.empty())
+    {
+      std::string const current = path.back().first;
+      std::vector<std::string> const & dependencies = GetDependencies(current);
+      if (path.back().second == dependencies.size())
+      {
+        states[current] = State::Visited;
+        order.push_back(current);
+        path.pop_back();
+        continue;
+      }
+
+      std::string const & dependency = dependencies[path.back().second++];
+      auto const & stateIt = states.find(dependency);
+      if (stateIt == states.cend())
+      {
+        states[dependency] = State::Visiting;
+        path.emplace_back(dependency, 0);
+      }
+      else if (stateIt->second == State::Visiting)
+      {
+        auto const & cycleBeginIt =
+            std::find_if(path.cbegin(), path.cend(), [&dependency](std::pair<std::string, size_t> const & item) {
+              return item.first == dependency;
+            });
+        for (auto it = cycleBeginIt; it != path.cend(); ++it)
+          cycle.push_back(it->first);
+        cycle.push_back(dependency);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Find the longest chain of dependent components. Components of one chain are installed
+ * one after another, so installation can't be faster than its critical path even with unlimited workers.
+ * @param installOrder components in order returned by GetInstallOrder
+ * @param durations expected durations of components, unknown durations are zero
+ * @param path components of critical path from dependency to dependent
+ * @return Duration of critical path
+ */
+std::chrono::milliseconds DependencyGraph::GetCriticalPath(
+    std::vector<std::string> const & installOrder,
+    std::unordered_map<std::string, std::chrono::milliseconds> const & durations,
+    std::vector<std::string> & path) const
+{
+  // Time when component is installed if it starts as soon as its dependencies are installed
+  std::unordered_map<std::string, std::chrono::milliseconds> finishTimes;
+  std::unordered_map<std::string, std::string> slowestDependencies;
+  std::string lastComponent;
+  std::chrono::milliseconds criticalDuration{0};
+  for (std::string const & component : installOrder)
+  {
+    std::chrono::milliseconds startTime{0};
+    std::string slowestDependency;
+    for (std::string const & dependency : GetDependencies(component))
+    {
+      auto const & finishIt = finishTimes.find(dependency);
+      if (finishIt != finishTimes.cend() && (slowestDependency.empty() || finishIt->second > startTime))
+      {
+        startTime = finishIt->second;
+        slowestDependency = dependency;
+      }
+    }
+    if (!slowestDependency.empty())
+      slowestDependencies[component] = slowestDependency;
+
+    auto const & durationIt = durations.find(component);
+    std::chrono::milliseconds const finishTime =
+        startTime + (durationIt == durations.cend() ? std::chrono::milliseconds(0) : durationIt->second);
+    finishTimes[component] = finishTime;
+    if (lastComponent.empty() || finishTime > criticalDuration)
+    {
+      criticalDuration = finishTime;
+      lastComponent = component;
+    }
+  }
+
+  path.clear();
+  for (std::string component = lastComponent; !component.empty();)
+  {
+    path.push_back(component);
+    auto const & dependencyIt = slowestDependencies.find(component);
+    component = dependencyIt == slowestDependencies.cend() ? "" : dependencyIt->second;
+  }
+  std::reverse(path.begin(), path.end());
+
+  return criticalDuration;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,44 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Graph of components and their dependencies by system identifiers.
+ * Components that aren't added are treated as components without dependencies.
+ */
+class DependencyGraph
+{
+public:
+  void AddComponent(std::string const & component, std::vector<std::string> const & dependencies);
+
+  bool Contains(std::string const & component) const;
+
+  std::vector<std::string> const & GetDependencies(std::string const & component) const;
+
+  bool GetInstallOrder(
+      std::vector<std::string> const & components,
+      std::vector<std::string> & order,
+      std::vector<std::string> & cycle) const;
+
+  std::chrono::milliseconds GetCriticalPath(
+      std::vector<std::string> const & installOrder,
+      std::unordered_map<std::string, std::chrono::milliseconds> const & durations,
+      std::vector<std::string> & path) const;
+
+protected:
+  std::unordered_map<std::string, std::vector<std::string>> m_dependencies;
+};
+
+}  // namespace componentUtils
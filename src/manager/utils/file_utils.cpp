@@ -0,0 +1,413 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "file_utils.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "hasher.hpp"
+
+namespace componentUtils
+{
+
+namespace
+{
+void AddFilesInDirectory(std::string const & path, std::string const & extension, std::vector<std::string> & filesPaths)
+{
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr)
+    return;
+
+  struct dirent * diread;
+  while ((diread = readdir(dir)) != nullptr)
+  {
+    // Hidden files and directories, e.g. .git, aren't a part of sources
+    std::string const filename = diread->d_name;
+    if (filename.empty() || filename[0] == '.')
+      continue;
+
+    std::string const filePath = path + "/" + filename;
+    if (FileUtils::IsDirectory(filePath))
+      AddFilesInDirectory(filePath, extension, filesPaths);
+    else if (
+        filename.size() > extension.size() &&
+        filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0)
+      filesPaths.push_back(filePath);
+  }
+  closedir(dir);
+}
+
+bool CopyFileContent(int sourceFd, int targetFd, size_t size, Hasher * hasher = nullptr)
+{
+  // copy_file_range copies in kernel, reads and writes are used if file systems don't support it
+  // or if content is hashed while it is copied
+  size_t copiedSize = 0;
+  while (hasher == nullptr && copiedSize < size)
+  {
+    ssize_t const result = copy_file_range(sourceFd, nullptr, targetFd, nullptr, size - copiedSize, 0);
+    if (result <= 0)
+      break;
+    copiedSize += result;
+  }
+
+  if (copiedSize == size)
+    return true;
+
+  size_t constexpr kBufferSize = 64 * 1024;
+  std::vector<char> buffer(kBufferSize);
+  while (true)
+  {
+    ssize_t const readSize = read(sourceFd, buffer.data(), buffer.size());
+    if (readSize < 0)
+      return false;
+    if (readSize == 0)
+      return true;
+
+    if (hasher != nullptr)
+      hasher->Update(buffer.data(), readSize);
+    ssize_t writtenSize = 0;
+    while (writtenSize < readSize)
+    {
+      ssize_t const result = write(targetFd, buffer.data() + writtenSize, readSize - writtenSize);
+      if (result < 0)
+        return false;
+      writtenSize += result;
+    }
+  }
+}
+}  // namespace
+
+/**
+ * @brief Make file with the same content without copying it if possible.
+ * File is cloned (reflink) if file system supports it, otherwise hardlink
+ * is created if it is allowed, otherwise content is copied.
+ * @param sourcePath path to existing file
+ * @param targetPath path to new file, existing file is replaced
+ * @param isHardlinkAllowed if true, then target file can share inode with source file,
+ * so it mustn't be changed in place
+ * @return true if file is copied
+ */
+bool FileUtils::CopyFile(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed)
+{
+  unlink(targetPath.c_str());
+
+  int const sourceFd = open(sourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (sourceFd < 0)
+    return false;
+
+  struct stat sourceStat = {};
+  if (fstat(sourceFd, &sourceStat) != 0)
+  {
+    close(sourceFd);
+    return false;
+  }
+
+  int const targetFd = open(targetPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, sourceStat.st_mode & 07777);
+  if (targetFd < 0)
+  {
+    close(sourceFd);
+    return false;
+  }
+
+  bool result = ioctl(targetFd, FICLONE, sourceFd) == 0;
+  if (!result && isHardlinkAllowed)
+  {
+    close(targetFd);
+    unlink(targetPath.c_str());
+    if (link(sourcePath.c_str(), targetPath.c_str()) == 0)
+    {
+      close(sourceFd);
+      return true;
+    }
+
+    int const copyTargetFd =
+        open(targetPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, sourceStat.st_mode & 07777);
+    if (copyTargetFd < 0)
+    {
+      close(sourceFd);
+      return false;
+    }
+    result = CopyFileContent(sourceFd, copyTargetFd, sourceStat.st_size);
+    close(copyTargetFd);
+  }
+  else
+  {
+    if (!result)
+      result = CopyFileContent(sourceFd, targetFd, sourceStat.st_size);
+    close(targetFd);
+  }
+
+  close(sourceFd);
+  return result;
+}
+
+/**
+ * @brief Copy content of file and hash it while it is copied, so file is read only once
+ * @param sourcePath path to existing file
+ * @param targetPath path to new file, existing file is replaced
+ * @param fileHash SHA-256 of file content
+ * @return true if file is copied
+ */
+bool FileUtils::CopyHashedFile(std::string const & sourcePath, std::string const & targetPath, std::string & fileHash)
+{
+  unlink(targetPath.c_str());
+
+  int const sourceFd = open(sourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (sourceFd < 0)
+    return false;
+
+  struct stat sourceStat = {};
+  if (fstat(sourceFd, &sourceStat) != 0)
+  {
+    close(sourceFd);
+    return false;
+  }
+
+  int const targetFd = open(targetPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, sourceStat.st_mode & 07777);
+  if (targetFd < 0)
+  {
+    close(sourceFd);
+    return false;
+  }
+
+  Hasher hasher;
+  bool const result = CopyFileContent(sourceFd, targetFd, sourceStat.st_size, &hasher);
+  close(targetFd);
+  close(sourceFd);
+
+  if (result)
+    fileHash = hasher.GetHash();
+  return result;
+}
+
+/**
+ * @brief Copy all files of directory recursively, see CopyFile
+ * @param sourcePath path to existing directory
+ * @param targetPath path to target directory, it is created if it doesn't exist
+ * @param isHardlinkAllowed if true, then target files can share inodes with source files
+ * @return true if all files are copied
+ */
+bool FileUtils::CopyDirectory(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed)
+{
+  DIR * dir = opendir(sourcePath.c_str());
+  if (dir == nullptr || !sc_fs_mkdirs(targetPath.c_str()))
+  {
+    if (dir != nullptr)
+      closedir(dir);
+    return false;
+  }
+
+  bool result = true;
+  struct dirent * diread;
+  while ((diread = readdir(dir)) != nullptr)
+  {
+    std::string const filename = diread->d_name;
+    if (filename == "." || filename == "..")
+      continue;
+
+    std::string const sourceFilePath = sourcePath + "/" + filename;
+    std::string const targetFilePath = targetPath + "/" + filename;
+    if (IsDirectory(sourceFilePath))
+      result = CopyDirectory(sourceFilePath, targetFilePath, isHardlinkAllowed) && result;
+    else
+      result = CopyFile(sourceFilePath, targetFilePath, isHardlinkAllowed) && result;
+  }
+  closedir(dir);
+
+  return result;
+}
+
+/**
+ * @brief Replace target directory by copy of source directory. Files are copied into
+ * temporary directory next to target, and it is renamed into target when all files are copied,
+ * so files of previous target aren't mixed with new ones and target is kept if copying fails.
+ * @param sourcePath path to existing directory
+ * @param targetPath path to target directory, its previous content is removed
+ * @param isHardlinkAllowed if true, then target files can share inodes with source files
+ * @return true if target directory is replaced
+ */
+bool FileUtils::ReplaceDirectory(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed)
+{
+  size_t const parentEnd = targetPath.rfind('/');
+  std::string const parentPath =
+      parentEnd == std::string::npos ? "." : (parentEnd == 0 ? "/" : targetPath.substr(0, parentEnd));
+  std::string const temporaryPath = MakeTemporaryDirectory(parentPath);
+  if (temporaryPath.empty())
+    return false;
+
+  if (!CopyDirectory(sourcePath, temporaryPath, isHardlinkAllowed))
+  {
+    RemoveDirectory(temporaryPath);
+    return false;
+  }
+
+  // Directory can't be renamed over non-empty directory, so previous target is moved aside first
+  std::string const previousPath = temporaryPath + ".previous";
+  bool const isPreviousMoved = rename(targetPath.c_str(), previousPath.c_str()) == 0;
+  if (rename(temporaryPath.c_str(), targetPath.c_str()) != 0)
+  {
+    if (isPreviousMoved)
+      rename(previousPath.c_str(), targetPath.c_str());
+    RemoveDirectory(temporaryPath);
+    return false;
+  }
+
+  if (isPreviousMoved)
+    RemoveDirectory(previousPath);
+  return true;
+}
+
+/**
+ * @brief Remove directory with all its content
+ * @param path path to directory
+ * @return true if directory is removed
+ */
+bool FileUtils::RemoveDirectory(std::string const & path)
+{
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr)
+    return false;
+
+  struct dirent * diread;
+  while ((diread = readdir(dir)) != nullptr)
+  {
+    std::string const filename = diread->d_name;
+    if (filename == "." || filename == "..")
+      continue;
+
+    std::string const filePath = path + "/" + filename;
+    if (IsDirectory(filePath))
+      RemoveDirectory(filePath);
+    else
+      unlink(filePath.c_str());
+  }
+  closedir(dir);
+
+  return rmdir(path.c_str()) == 0;
+}
+
+bool FileUtils::IsDirectory(std::string const & path)
+{
+  struct stat pathStat = {};
+  return lstat(path.c_str(), &pathStat) == 0 && S_ISDIR(pathStat.st_mode);
+}
+
+bool FileUtils::IsDirectoryEmpty(std::string const & path)
+{
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr)
+    return true;
+
+  bool result = true;
+  struct dirent * diread;
+  while ((diread = readdir(dir)) != nullptr)
+  {
+    std::string const filename = diread->d_name;
+    if (filename != "." && filename != "..")
+    {
+      result = false;
+      break;
+    }
+  }
+  closedir(dir);
+
+  return result;
+}
+
+/**
+ * @brief Get size of file or total size of directory files
+ * @param path path to file or directory
+ * @return Size in bytes, return 0 if path doesn't exist
+ */
+size_t FileUtils::GetSize(std::string const & path)
+{
+  struct stat pathStat = {};
+  if (lstat(path.c_str(), &pathStat) != 0)
+    return 0;
+
+  if (!S_ISDIR(pathStat.st_mode))
+    return pathStat.st_size;
+
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr)
+    return 0;
+
+  size_t size = 0;
+  struct dirent * diread;
+  while ((diread = readdir(dir)) != nullptr)
+  {
+    std::string const filename = diread->d_name;
+    if (filename != "." && filename != "..")
+      size += GetSize(path + "/" + filename);
+  }
+  closedir(dir);
+
+  return size;
+}
+
+/**
+ * @brief Find files with extension in directory and its subdirectories.
+ * Hidden files and directories are skipped, symbolic links to directories aren't followed.
+ * @param path path to directory
+ * @param extension extension of files with dot, e.g. ".scs"
+ * @return Sorted paths of files
+ */
+std::vector<std::string> FileUtils::GetFilesInDirectory(std::string const & path, std::string const & extension)
+{
+  std::vector<std::string> filesPaths;
+  AddFilesInDirectory(path, extension, filesPaths);
+  std::sort(filesPaths.begin(), filesPaths.end());
+  return filesPaths;
+}
+
+/**
+ * @brief Check if path matches one of glob patterns. `*` matches `/` too,
+ * and pattern without wildcards matches directory with all its files.
+ * @param relativePath path relative to root of patterns
+ * @param patterns glob patterns, e.g. "docs" or "*.scs"
+ * @return true if path matches one of patterns
+ */
+bool FileUtils::IsPathMatched(std::string const & relativePath, std::vector<std::string> const & patterns)
+{
+  return std::any_of(patterns.cbegin(), patterns.cend(), [&relativePath](std::string const & pattern) {
+    return fnmatch(pattern.c_str(), relativePath.c_str(), 0) == 0 ||
+           fnmatch((pattern + "/*").c_str(), relativePath.c_str(), 0) == 0;
+  });
+}
+
+/**
+ * @brief Create new directory with unique name
+ * @param parentPath directory where new directory is created
+ * @return Path to created directory, return empty string if it isn't created
+ */
+std::string FileUtils::MakeTemporaryDirectory(std::string const & parentPath)
+{
+  if (!sc_fs_mkdirs(parentPath.c_str()))
+    return "";
+
+  std::string pathTemplate = parentPath + "/tmp.XXXXXX";
+  if (mkdtemp(&pathTemplate[0]) == nullptr)
+    return "";
+
+  return pathTemplate;
+}
+
+}  // namespace componentUtils
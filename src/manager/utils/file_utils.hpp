@@ -0,0 +1,41 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace componentUtils
+{
+
+class FileUtils
+{
+public:
+  static bool CopyFile(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed);
+
+  static bool CopyHashedFile(std::string const & sourcePath, std::string const & targetPath, std::string & fileHash);
+
+  static bool CopyDirectory(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed);
+
+  static bool ReplaceDirectory(std::string const & sourcePath, std::string const & targetPath, bool isHardlinkAllowed);
+
+  static bool RemoveDirectory(std::string const & path);
+
+  static bool IsDirectory(std::string const & path);
+
+  static bool IsDirectoryEmpty(std::string const & path);
+
+  static size_t GetSize(std::string const & path);
+
+  static std::vector<std::string> GetFilesInDirectory(std::string const & path, std::string const & extension);
+
+  static bool IsPathMatched(std::string const & relativePath, std::vector<std::string> const & patterns);
+
+  static std::string MakeTemporaryDirectory(std::string const & parentPath);
+};
+
+}  // namespace componentUtils
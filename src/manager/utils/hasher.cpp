@@ -0,0 +1,67 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "hasher.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace componentUtils
+{
+
+Hasher::Hasher()
+  : m_checksum(g_checksum_new(G_CHECKSUM_SHA256))
+{
+}
+
+Hasher::~Hasher()
+{
+  g_checksum_free(m_checksum);
+}
+
+void Hasher::Update(char const * data, size_t size)
+{
+  g_checksum_update(m_checksum, reinterpret_cast<guchar const *>(data), static_cast<gssize>(size));
+}
+
+/**
+ * @brief Get hash of all added data. Data can't be added after this call.
+ * @return Hex string of SHA-256 hash
+ */
+std::string Hasher::GetHash() const
+{
+  return g_checksum_get_string(m_checksum);
+}
+
+std::string Hasher::GetStringHash(std::string const & content)
+{
+  Hasher hasher;
+  hasher.Update(content.data(), content.size());
+  return hasher.GetHash();
+}
+
+/**
+ * @brief Get hash of file content
+ * @param filePath path to file
+ * @return Hex string of SHA-256 hash, return empty string if file can't be read
+ */
+std::string Hasher::GetFileHash(std::string const & filePath)
+{
+  size_t constexpr kBufferSize = 64 * 1024;
+
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open())
+    return "";
+
+  Hasher hasher;
+  std::vector<char> buffer(kBufferSize);
+  while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+    hasher.Update(buffer.data(), file.gcount());
+
+  return hasher.GetHash();
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,42 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+
+#include <glib.h>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Incremental SHA-256 hasher. Data can be added
+ * by parts while it is read or downloaded.
+ */
+class Hasher
+{
+public:
+  Hasher();
+
+  Hasher(Hasher const &) = delete;
+  Hasher & operator=(Hasher const &) = delete;
+
+  ~Hasher();
+
+  void Update(char const * data, size_t size);
+
+  std::string GetHash() const;
+
+  static std::string GetStringHash(std::string const & content);
+
+  static std::string GetFileHash(std::string const & filePath);
+
+protected:
+  GChecksum * m_checksum;
+};
+
+}  // namespace componentUtils
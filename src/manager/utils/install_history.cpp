@@ -0,0 +1,39 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "install_history.hpp"
+
+namespace componentUtils
+{
+
+InstallHistory::InstallHistory(std::string historyPath)
+  : PersistentStore(std::move(historyPath))
+{
+}
+
+bool InstallHistory::ParseEntry(std::vector<std::string> const & fields, InstallHistoryEntry & entry) const
+{
+  uint64_t downloadDuration;
+  uint64_t scriptsDuration;
+  if (fields.size() != 3 || !TabSeparatedFile::ParseValue(fields[0], entry.downloadedBytes) ||
+      !TabSeparatedFile::ParseValue(fields[1], downloadDuration) ||
+      !TabSeparatedFile::ParseValue(fields[2], scriptsDuration))
+    return false;
+
+  entry.downloadDuration = std::chrono::milliseconds(downloadDuration);
+  entry.scriptsDuration = std::chrono::milliseconds(scriptsDuration);
+  return true;
+}
+
+std::vector<std::string> InstallHistory::FormatEntry(InstallHistoryEntry const & entry) const
+{
+  return {
+      TabSeparatedFile::FormatValue(entry.downloadedBytes),
+      TabSeparatedFile::FormatValue(entry.downloadDuration.count()),
+      TabSeparatedFile::FormatValue(entry.scriptsDuration.count())};
+}
+
+}  // namespace componentUtils
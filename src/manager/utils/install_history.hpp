@@ -0,0 +1,50 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "persistent_store.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Costs of the last installation of component.
+ */
+struct InstallHistoryEntry
+{
+  // Size of the last full download, updates by changes don't change it
+  uint64_t downloadedBytes = 0;
+  std::chrono::milliseconds downloadDuration{0};
+  std::chrono::milliseconds scriptsDuration{0};
+
+  std::chrono::milliseconds GetDuration() const
+  {
+    return downloadDuration + scriptsDuration;
+  }
+};
+
+/**
+ * @brief Persisted map from system identifier of installed component
+ * to costs of its last installation. All methods are thread safe.
+ */
+class InstallHistory : public PersistentStore<InstallHistoryEntry>
+{
+public:
+  explicit InstallHistory(std::string historyPath);
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, InstallHistoryEntry & entry) const override;
+
+  std::vector<std::string> FormatEntry(InstallHistoryEntry const & entry) const override;
+};
+
+}  // namespace componentUtils
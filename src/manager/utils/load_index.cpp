@@ -0,0 +1,77 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "load_index.hpp"
+
+#include <sys/stat.h>
+
+#include "hasher.hpp"
+
+namespace componentUtils
+{
+
+LoadIndex::LoadIndex(std::string indexPath)
+  : PersistentStore(std::move(indexPath))
+{
+}
+
+/**
+ * @brief Check if file is changed since it was loaded
+ * @param filePath path to file
+ * @param entry current state of file, it should be passed to Update after file is loaded
+ * @return true if file isn't indexed, or it can't be read, or its content is changed
+ */
+bool LoadIndex::IsChanged(std::string const & filePath, LoadIndexEntry & entry) const
+{
+  entry = LoadIndexEntry();
+  struct stat fileStat;
+  if (stat(filePath.c_str(), &fileStat) != 0)
+    return true;
+
+  entry.modificationTime =
+      static_cast<uint64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + static_cast<uint64_t>(fileStat.st_mtim.tv_nsec);
+  entry.size = static_cast<uint64_t>(fileStat.st_size);
+
+  LoadIndexEntry indexedEntry;
+  if (!Find(filePath, indexedEntry))
+  {
+    entry.hash = Hasher::GetFileHash(filePath);
+    return true;
+  }
+
+  if (indexedEntry.modificationTime == entry.modificationTime && indexedEntry.size == entry.size)
+  {
+    entry.hash = indexedEntry.hash;
+    return false;
+  }
+
+  // Touched file with the same content isn't loaded again
+  entry.hash = Hasher::GetFileHash(filePath);
+  return entry.hash.empty() || entry.hash != indexedEntry.hash;
+}
+
+void LoadIndex::Update(std::string const & filePath, LoadIndexEntry const & entry)
+{
+  if (entry.hash.empty())
+    Remove(filePath);
+  else
+    PersistentStore::Update(filePath, entry);
+}
+
+bool LoadIndex::ParseEntry(std::vector<std::string> const & fields, LoadIndexEntry & entry) const
+{
+  entry.hash = fields.size() == 3 ? fields[2] : "";
+  return !entry.hash.empty() && TabSeparatedFile::ParseValue(fields[0], entry.modificationTime) &&
+         TabSeparatedFile::ParseValue(fields[1], entry.size);
+}
+
+std::vector<std::string> LoadIndex::FormatEntry(LoadIndexEntry const & entry) const
+{
+  return {
+      TabSeparatedFile::FormatValue(entry.modificationTime), TabSeparatedFile::FormatValue(entry.size), entry.hash};
+}
+
+}  // namespace componentUtils
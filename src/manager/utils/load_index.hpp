@@ -0,0 +1,48 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "persistent_store.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief State of file at the moment it was loaded into sc-memory.
+ */
+struct LoadIndexEntry
+{
+  uint64_t modificationTime = 0;
+  uint64_t size = 0;
+  std::string hash;
+};
+
+/**
+ * @brief Persisted map from path of loaded .scs file to its state, so unchanged
+ * files aren't loaded again. File is hashed only if its modification time or size
+ * are changed. All methods are thread safe.
+ */
+class LoadIndex : public PersistentStore<LoadIndexEntry>
+{
+public:
+  explicit LoadIndex(std::string indexPath);
+
+  bool IsChanged(std::string const & filePath, LoadIndexEntry & entry) const;
+
+  void Update(std::string const & filePath, LoadIndexEntry const & entry);
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, LoadIndexEntry & entry) const override;
+
+  std::vector<std::string> FormatEntry(LoadIndexEntry const & entry) const override;
+};
+
+}  // namespace componentUtils
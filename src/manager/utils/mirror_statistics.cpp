@@ -0,0 +1,118 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "mirror_statistics.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "src/manager/utils/sc_component_utils.hpp"
+
+namespace
+{
+// Weight of the last download in moving averages
+double constexpr kAverageWeight = 0.3;
+// Failed download costs as much as download that lasts this time
+double constexpr kFailurePenalty = 60000;
+// Unknown address is tried after known alive addresses, but before addresses that fail often
+double constexpr kUnknownLatency = kFailurePenalty / 2;
+}  // namespace
+
+namespace componentUtils
+{
+
+MirrorStatistics::MirrorStatistics(std::string statisticsPath)
+  : PersistentStore(std::move(statisticsPath))
+{
+}
+
+bool MirrorStatistics::Find(std::string const & url, MirrorEntry & entry) const
+{
+  return PersistentStore::Find(UrlUtils::NormalizeUrl(url), entry);
+}
+
+/**
+ * @brief Remember result of download from address
+ * @param url address
+ * @param isSuccess true if address is downloaded
+ * @param latency duration of download
+ */
+void MirrorStatistics::Update(std::string const & url, bool isSuccess, std::chrono::milliseconds latency)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  MirrorEntry & entry = m_entries[UrlUtils::NormalizeUrl(url)];
+
+  entry.failureRate = entry.failureRate * (1 - kAverageWeight) + (isSuccess ? 0 : kAverageWeight);
+  if (!isSuccess)
+  {
+    ++entry.failuresCount;
+    return;
+  }
+
+  entry.averageLatency = entry.successesCount == 0
+                             ? latency
+                             : std::chrono::milliseconds(static_cast<long long>(
+                                   entry.averageLatency.count() * (1 - kAverageWeight) +
+                                   latency.count() * kAverageWeight));
+  ++entry.successesCount;
+}
+
+/**
+ * @brief Order addresses by expected download time. Addresses
+ * with equal expectations keep their order.
+ * @param urls alternative addresses
+ * @return Indexes of addresses, the best address is the first
+ */
+std::vector<size_t> MirrorStatistics::GetOrder(std::vector<std::string> const & urls) const
+{
+  std::vector<double> expectedLatencies;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::string const & url : urls)
+      expectedLatencies.push_back(GetExpectedLatency(url));
+  }
+
+  std::vector<size_t> order(urls.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&expectedLatencies](size_t first, size_t second) {
+    return expectedLatencies[first] < expectedLatencies[second];
+  });
+  return order;
+}
+
+bool MirrorStatistics::ParseEntry(std::vector<std::string> const & fields, MirrorEntry & entry) const
+{
+  long long latency = 0;
+  if (fields.size() != 4 || !TabSeparatedFile::ParseValue(fields[0], entry.successesCount) ||
+      !TabSeparatedFile::ParseValue(fields[1], entry.failuresCount) ||
+      !TabSeparatedFile::ParseValue(fields[2], latency) || !TabSeparatedFile::ParseValue(fields[3], entry.failureRate))
+    return false;
+
+  entry.averageLatency = std::chrono::milliseconds(latency);
+  return true;
+}
+
+std::vector<std::string> MirrorStatistics::FormatEntry(MirrorEntry const & entry) const
+{
+  return {
+      TabSeparatedFile::FormatValue(entry.successesCount),
+      TabSeparatedFile::FormatValue(entry.failuresCount),
+      TabSeparatedFile::FormatValue(entry.averageLatency.count()),
+      TabSeparatedFile::FormatValue(entry.failureRate)};
+}
+
+double MirrorStatistics::GetExpectedLatency(std::string const & url) const
+{
+  auto const & it = m_entries.find(UrlUtils::NormalizeUrl(url));
+  if (it == m_entries.cend())
+    return kUnknownLatency;
+
+  MirrorEntry const & entry = it->second;
+  double const latency = entry.successesCount == 0 ? kFailurePenalty : entry.averageLatency.count();
+  return latency + entry.failureRate * kFailurePenalty;
+}
+
+}  // namespace componentUtils
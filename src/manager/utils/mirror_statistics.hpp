@@ -0,0 +1,55 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "persistent_store.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Download history of one address.
+ */
+struct MirrorEntry
+{
+  size_t successesCount = 0;
+  size_t failuresCount = 0;
+  // Moving average of successful downloads latency
+  std::chrono::milliseconds averageLatency{0};
+  // Moving average of failures, 0 if address never failed recently, 1 if it always fails
+  double failureRate = 0;
+};
+
+/**
+ * @brief Persisted latency and failures of alternative addresses.
+ * Addresses are ordered by expected download time, so the fastest
+ * alive mirror is tried first. All methods are thread safe.
+ */
+class MirrorStatistics : public PersistentStore<MirrorEntry>
+{
+public:
+  explicit MirrorStatistics(std::string statisticsPath);
+
+  bool Find(std::string const & url, MirrorEntry & entry) const;
+
+  void Update(std::string const & url, bool isSuccess, std::chrono::milliseconds latency);
+
+  std::vector<size_t> GetOrder(std::vector<std::string> const & urls) const;
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, MirrorEntry & entry) const override;
+
+  std::vector<std::string> FormatEntry(MirrorEntry const & entry) const override;
+
+  double GetExpectedLatency(std::string const & url) const;
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,97 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "persistent_store.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include <sc-memory/sc_debug.hpp>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Read lines of file
+ * @param filePath path to file
+ * @return Fields of each non-empty line, return empty vector if file doesn't exist
+ */
+std::vector<std::vector<std::string>> TabSeparatedFile::Read(std::string const & filePath)
+{
+  std::vector<std::vector<std::string>> lines;
+  std::ifstream file(filePath);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.empty())
+      continue;
+
+    // Empty fields are kept, so the last field can be empty
+    std::vector<std::string> fields;
+    size_t fieldStart = 0;
+    for (size_t fieldEnd = line.find('\t'); fieldEnd != std::string::npos; fieldEnd = line.find('\t', fieldStart))
+    {
+      fields.push_back(line.substr(fieldStart, fieldEnd - fieldStart));
+      fieldStart = fieldEnd + 1;
+    }
+    fields.push_back(line.substr(fieldStart));
+    lines.push_back(std::move(fields));
+  }
+
+  return lines;
+}
+
+/**
+ * @brief Replace file by lines. Lines are written into temporary file that is renamed
+ * only if it is fully written, so file isn't broken if process is stopped or disk is full.
+ * @param filePath path to file, its directory is created if it doesn't exist
+ * @param lines fields of lines, fields must not contain tabs and line breaks
+ * @return true if file is replaced
+ */
+bool TabSeparatedFile::Write(std::string const & filePath, std::vector<std::vector<std::string>> const & lines)
+{
+  std::string const temporaryPath = filePath + ".tmp";
+  size_t const directoryEnd = filePath.rfind('/');
+  if (directoryEnd != std::string::npos && directoryEnd != 0 &&
+      !sc_fs_mkdirs(filePath.substr(0, directoryEnd).c_str()))
+  {
+    SC_LOG_WARNING("TabSeparatedFile: Can't create directory of \"" + filePath + "\"");
+    return false;
+  }
+
+  std::ofstream file(temporaryPath, std::ios::trunc);
+  for (std::vector<std::string> const & fields : lines)
+  {
+    for (size_t i = 0; i < fields.size(); ++i)
+      file << (i == 0 ? "" : "\t") << fields[i];
+    file << '\n';
+  }
+
+  // Errors of buffered writes are reported only when file is closed
+  file.close();
+  if (file.fail())
+  {
+    SC_LOG_WARNING("TabSeparatedFile: Can't write \"" + temporaryPath + "\"");
+    std::remove(temporaryPath.c_str());
+    return false;
+  }
+
+  if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+  {
+    SC_LOG_WARNING("TabSeparatedFile: Can't save \"" + filePath + "\"");
+    std::remove(temporaryPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,128 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Text file of lines with tab separated fields.
+ */
+class TabSeparatedFile
+{
+public:
+  static std::vector<std::vector<std::string>> Read(std::string const & filePath);
+
+  static bool Write(std::string const & filePath, std::vector<std::vector<std::string>> const & lines);
+
+  template <class TValue>
+  static bool ParseValue(std::string const & field, TValue & value)
+  {
+    std::istringstream fieldStream(field);
+    return fieldStream >> value && (fieldStream >> std::ws).eof();
+  }
+
+  template <class TValue>
+  static std::string FormatValue(TValue const & value)
+  {
+    std::ostringstream fieldStream;
+    fieldStream << value;
+    return fieldStream.str();
+  }
+};
+
+/**
+ * @brief Map from key to entry that is kept in tab separated file, one line per entry
+ * with key in the first field. Missing file means empty map. Derived classes
+ * parse and format fields of their entries. All methods are thread safe.
+ */
+template <class TEntry>
+class PersistentStore
+{
+public:
+  explicit PersistentStore(std::string filePath)
+    : m_filePath(std::move(filePath))
+  {
+  }
+
+  virtual ~PersistentStore() = default;
+
+  /**
+   * @brief Read entries from file. Lines that can't be parsed are skipped.
+   */
+  void Load()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+
+    for (std::vector<std::string> const & fields : TabSeparatedFile::Read(m_filePath))
+    {
+      TEntry entry;
+      if (!fields.front().empty() && ParseEntry({fields.cbegin() + 1, fields.cend()}, entry))
+        m_entries[fields.front()] = entry;
+    }
+  }
+
+  /**
+   * @brief Write entries to file. Previous file is kept if entries can't be written.
+   * @return true if entries are written
+   */
+  bool Save() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::vector<std::string>> lines;
+    for (auto const & it : m_entries)
+    {
+      std::vector<std::string> fields = {it.first};
+      std::vector<std::string> const entryFields = FormatEntry(it.second);
+      fields.insert(fields.cend(), entryFields.cbegin(), entryFields.cend());
+      lines.push_back(std::move(fields));
+    }
+
+    return TabSeparatedFile::Write(m_filePath, lines);
+  }
+
+  bool Find(std::string const & key, TEntry & entry) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const & it = m_entries.find(key);
+    if (it == m_entries.cend())
+      return false;
+
+    entry = it->second;
+    return true;
+  }
+
+  void Update(std::string const & key, TEntry const & entry)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[key] = entry;
+  }
+
+  void Remove(std::string const & key)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(key);
+  }
+
+protected:
+  std::string m_filePath;
+  std::map<std::string, TEntry> m_entries;
+  mutable std::mutex m_mutex;
+
+  virtual bool ParseEntry(std::vector<std::string> const & fields, TEntry & entry) const = 0;
+
+  virtual std::vector<std::string> FormatEntry(TEntry const & entry) const = 0;
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,428 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "process_runner.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sc-memory/sc_debug.hpp>
+
+extern char ** environ;
+
+namespace componentUtils
+{
+
+namespace
+{
+// Epoll event data keeps pid of process and kind of its descriptor
+uint64_t constexpr kOutputFd = 0;
+uint64_t constexpr kErrorFd = 1;
+uint64_t constexpr kPidFd = 2;
+uint64_t constexpr kWakeFd = 3;
+
+size_t constexpr kMaxCapturedOutputSize = 1024 * 1024;
+// Time between SIGTERM and SIGKILL of timed out process
+std::chrono::seconds constexpr kKillDelay{5};
+// Exit of processes is checked with this period if pidfd isn't supported
+std::chrono::milliseconds constexpr kReapPeriod{100};
+
+uint64_t GetEventData(pid_t pid, uint64_t kind)
+{
+  return (static_cast<uint64_t>(pid) << 2) | kind;
+}
+
+void AddFd(int epollFd, int fd, uint64_t data)
+{
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.u64 = data;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+}
+}  // namespace
+
+std::string ProcessResult::ToString() const
+{
+  if (!isStarted)
+    return "process isn't started";
+  if (isTimedOut)
+    return "process is terminated by timeout";
+  if (signal != 0)
+    return "process is killed by signal " + std::to_string(signal);
+  return "exit code " + std::to_string(exitCode);
+}
+
+ProcessRunner::ProcessRunner()
+  : m_epollFd(epoll_create1(EPOLL_CLOEXEC))
+  , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+  AddFd(m_epollFd, m_wakeFd, kWakeFd);
+  m_loop = std::thread(&ProcessRunner::Loop, this);
+}
+
+/**
+ * @brief Kill running processes and wait for their exit.
+ */
+ProcessRunner::~ProcessRunner()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopped = true;
+    for (auto const & it : m_processes)
+      kill(-it.first, SIGKILL);
+  }
+  Wake();
+  m_loop.join();
+
+  close(m_wakeFd);
+  close(m_epollFd);
+}
+
+/**
+ * @brief Start process
+ * @param options program, its arguments and limits
+ * @return Future result of process, it is ready when process exits
+ */
+std::future<ProcessResult> ProcessRunner::Start(ProcessOptions const & options)
+{
+  std::unique_ptr<Process> process = std::make_unique<Process>();
+  std::future<ProcessResult> result = process->promise.get_future();
+  if (options.arguments.empty())
+  {
+    process->promise.set_value(process->result);
+    return result;
+  }
+
+  process->name = options.arguments.front();
+  process->isOutputCaptured = options.isOutputCaptured;
+  process->outputConsumer = options.outputConsumer;
+
+  int outputPipe[2];
+  int errorPipe[2];
+  if (pipe2(outputPipe, O_CLOEXEC) != 0)
+  {
+    SC_LOG_ERROR("ProcessRunner: Can't create pipe for \"" + process->name + "\"");
+    process->promise.set_value(process->result);
+    return result;
+  }
+  if (pipe2(errorPipe, O_CLOEXEC) != 0)
+  {
+    close(outputPipe[0]);
+    close(outputPipe[1]);
+    SC_LOG_ERROR("ProcessRunner: Can't create pipe for \"" + process->name + "\"");
+    process->promise.set_value(process->result);
+    return result;
+  }
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+  posix_spawn_file_actions_adddup2(&actions, outputPipe[1], STDOUT_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, errorPipe[1], STDERR_FILENO);
+  if (!options.workingDirectory.empty())
+    posix_spawn_file_actions_addchdir_np(&actions, options.workingDirectory.c_str());
+
+  // Process gets its own group, so it is terminated together with its children
+  posix_spawnattr_t attributes;
+  posix_spawnattr_init(&attributes);
+  sigset_t signals;
+  sigemptyset(&signals);
+  posix_spawnattr_setsigmask(&attributes, &signals);
+  sigaddset(&signals, SIGPIPE);
+  posix_spawnattr_setsigdefault(&attributes, &signals);
+  posix_spawnattr_setpgroup(&attributes, 0);
+  posix_spawnattr_setflags(
+      &attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+  std::vector<char *> arguments;
+  for (std::string const & argument : options.arguments)
+    arguments.push_back(const_cast<char *>(argument.c_str()));
+  arguments.push_back(nullptr);
+
+  int const spawnError =
+      posix_spawnp(&process->pid, arguments.front(), &actions, &attributes, arguments.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  posix_spawnattr_destroy(&attributes);
+  close(outputPipe[1]);
+  close(errorPipe[1]);
+
+  if (spawnError != 0)
+  {
+    close(outputPipe[0]);
+    close(errorPipe[0]);
+    SC_LOG_ERROR("ProcessRunner: Can't start \"" + process->name + "\": " + std::strerror(spawnError));
+    process->promise.set_value(process->result);
+    return result;
+  }
+
+  process->result.isStarted = true;
+  process->outputFd = outputPipe[0];
+  process->errorFd = errorPipe[0];
+  fcntl(process->outputFd, F_SETFL, O_NONBLOCK);
+  fcntl(process->errorFd, F_SETFL, O_NONBLOCK);
+
+  if (options.cpuTimeout.count() > 0)
+  {
+    rlimit const cpuLimit = {
+        static_cast<rlim_t>(options.cpuTimeout.count()), static_cast<rlim_t>(options.cpuTimeout.count() + 1)};
+    prlimit(process->pid, RLIMIT_CPU, &cpuLimit, nullptr);
+  }
+  if (options.timeout.count() > 0)
+    process->deadline = Clock::now() + options.timeout;
+
+#ifdef SYS_pidfd_open
+  process->pidFd = static_cast<int>(syscall(SYS_pidfd_open, process->pid, 0));
+#endif
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AddFd(m_epollFd, process->outputFd, GetEventData(process->pid, kOutputFd));
+    AddFd(m_epollFd, process->errorFd, GetEventData(process->pid, kErrorFd));
+    if (process->pidFd >= 0)
+      AddFd(m_epollFd, process->pidFd, GetEventData(process->pid, kPidFd));
+    m_processes[process->pid] = std::move(process);
+  }
+  Wake();
+
+  return result;
+}
+
+/**
+ * @brief Start process and wait for its exit
+ * @param options program, its arguments and limits
+ * @return Result of process
+ */
+ProcessResult ProcessRunner::Run(ProcessOptions const & options)
+{
+  return Start(options).get();
+}
+
+void ProcessRunner::Loop()
+{
+  size_t constexpr kMaxEventsCount = 32;
+  epoll_event events[kMaxEventsCount];
+
+  while (true)
+  {
+    int timeout = -1;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_isStopped && m_processes.empty())
+        return;
+
+      Clock::time_point const now = Clock::now();
+      for (auto const & it : m_processes)
+      {
+        Process const & process = *it.second;
+        Clock::time_point const deadline = std::min(process.deadline, process.killDeadline);
+        if (process.pidFd < 0 || m_isStopped)
+          timeout = timeout < 0 ? kReapPeriod.count() : std::min<int>(timeout, kReapPeriod.count());
+        if (deadline != Clock::time_point::max())
+        {
+          int const deadlineTimeout = static_cast<int>(
+              std::max<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count(), 0) + 1);
+          timeout = timeout < 0 ? deadlineTimeout : std::min(timeout, deadlineTimeout);
+        }
+      }
+    }
+
+    int const eventsCount = epoll_wait(m_epollFd, events, kMaxEventsCount, timeout);
+    if (eventsCount < 0 && errno != EINTR)
+    {
+      SC_LOG_ERROR("ProcessRunner: Can't wait for processes events");
+      return;
+    }
+
+    std::vector<std::unique_ptr<Process>> exitedProcesses;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (int i = 0; i < eventsCount; ++i)
+      {
+        uint64_t const kind = events[i].data.u64 & 3;
+        if (kind == kWakeFd)
+        {
+          uint64_t value;
+          read(m_wakeFd, &value, sizeof(value));
+          continue;
+        }
+
+        auto const & it = m_processes.find(static_cast<pid_t>(events[i].data.u64 >> 2));
+        if (it == m_processes.cend())
+          continue;
+
+        Process & process = *it->second;
+        if (kind == kOutputFd)
+          ReadOutput(process, process.outputFd, false);
+        else if (kind == kErrorFd)
+          ReadOutput(process, process.errorFd, true);
+      }
+
+      Clock::time_point const now = Clock::now();
+      for (auto it = m_processes.begin(); it != m_processes.end();)
+      {
+        Process & process = *it->second;
+        if (now >= process.killDeadline)
+        {
+          kill(-process.pid, SIGKILL);
+          process.killDeadline = Clock::time_point::max();
+        }
+        else if (now >= process.deadline)
+        {
+          SC_LOG_WARNING("ProcessRunner: \"" + process.name + "\" is terminated by timeout");
+          process.result.isTimedOut = true;
+          kill(-process.pid, SIGTERM);
+          process.deadline = Clock::time_point::max();
+          process.killDeadline = now + kKillDelay;
+        }
+
+        if (Reap(process))
+        {
+          exitedProcesses.push_back(std::move(it->second));
+          it = m_processes.erase(it);
+        }
+        else
+          ++it;
+      }
+    }
+
+    for (std::unique_ptr<Process> const & process : exitedProcesses)
+      process->promise.set_value(std::move(process->result));
+  }
+}
+
+void ProcessRunner::Wake() const
+{
+  uint64_t const value = 1;
+  write(m_wakeFd, &value, sizeof(value));
+}
+
+/**
+ * @brief Read available output of process and write its complete lines
+ * @param process process
+ * @param fd descriptor of stdout or stderr pipe, it is closed at the end of output
+ * @param isError true if fd is stderr
+ */
+void ProcessRunner::ReadOutput(Process & process, int & fd, bool isError)
+{
+  if (fd < 0)
+    return;
+
+  std::string & buffer = isError ? process.errorLine : process.outputLine;
+  char data[4096];
+  while (true)
+  {
+    ssize_t const readSize = read(fd, data, sizeof(data));
+    if (readSize > 0 && !isError && process.outputConsumer)
+    {
+      // Process gets SIGPIPE on the next write if its output is rejected
+      if (!process.outputConsumer(data, readSize))
+      {
+        CloseFd(fd);
+        return;
+      }
+      continue;
+    }
+    if (readSize > 0)
+    {
+      buffer.append(data, readSize);
+      continue;
+    }
+
+    if (readSize == 0 || (errno != EAGAIN && errno != EINTR))
+    {
+      WriteLines(process, buffer, isError, true);
+      CloseFd(fd);
+      return;
+    }
+    if (errno == EAGAIN)
+      break;
+  }
+
+  WriteLines(process, buffer, isError, false);
+}
+
+void ProcessRunner::WriteLines(Process & process, std::string & buffer, bool isError, bool isFinal)
+{
+  if (!isError && process.isOutputCaptured)
+  {
+    size_t const freeSize = kMaxCapturedOutputSize - std::min(kMaxCapturedOutputSize, process.result.output.size());
+    process.result.output.append(buffer, 0, std::min(freeSize, buffer.size()));
+    buffer.clear();
+    return;
+  }
+
+  size_t lineBegin = 0;
+  size_t lineEnd;
+  while ((lineEnd = buffer.find('\n', lineBegin)) != std::string::npos || (isFinal && lineBegin < buffer.size()))
+  {
+    if (lineEnd == std::string::npos)
+      lineEnd = buffer.size();
+
+    std::string const line = buffer.substr(lineBegin, lineEnd - lineBegin);
+    if (isError)
+    {
+      if (process.result.errorOutput.size() < kMaxCapturedOutputSize)
+        process.result.errorOutput += line + "\n";
+      SC_LOG_WARNING("[" + process.name + "] " + line);
+    }
+    else
+      SC_LOG_INFO("[" + process.name + "] " + line);
+    lineBegin = lineEnd + 1;
+  }
+  buffer.erase(0, std::min(lineBegin, buffer.size()));
+}
+
+/**
+ * @brief Get exit status of process if it is exited. Output that
+ * is left in pipes is read, pipes are closed.
+ * @param process process
+ * @return true if process is exited
+ */
+bool ProcessRunner::Reap(Process & process)
+{
+  int status = 0;
+  if (waitpid(process.pid, &status, WNOHANG) != process.pid)
+    return false;
+
+  if (WIFEXITED(status))
+    process.result.exitCode = WEXITSTATUS(status);
+  else if (WIFSIGNALED(status))
+    process.result.signal = WTERMSIG(status);
+
+  // Children of process can keep pipes open, so only already written output is read
+  ReadOutput(process, process.outputFd, false);
+  ReadOutput(process, process.errorFd, true);
+  WriteLines(process, process.outputLine, false, true);
+  WriteLines(process, process.errorLine, true, true);
+  CloseFd(process.outputFd);
+  CloseFd(process.errorFd);
+  CloseFd(process.pidFd);
+
+  return true;
+}
+
+void ProcessRunner::CloseFd(int & fd)
+{
+  if (fd < 0)
+    return;
+
+  epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  fd = -1;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,116 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace componentUtils
+{
+
+struct ProcessOptions
+{
+  // Program and its arguments, program is searched in PATH if it has no slashes
+  std::vector<std::string> arguments;
+  // Directory where program is started, current directory is used if it is empty
+  std::string workingDirectory;
+  // Process is terminated if it runs longer, zero means no limit
+  std::chrono::milliseconds timeout{0};
+  // Process is killed by kernel if it uses more CPU time, zero means no limit
+  std::chrono::seconds cpuTimeout{0};
+  // If true, then stdout is saved into result instead of log
+  bool isOutputCaptured = false;
+  // If set, then stdout is passed to consumer as soon as it is read. Consumer is called by thread
+  // of runner, so it mustn't block. Pipe is closed after consumer returns false.
+  std::function<bool(char const * data, size_t size)> outputConsumer;
+};
+
+struct ProcessResult
+{
+  bool isStarted = false;
+  int exitCode = -1;
+  int signal = 0;
+  bool isTimedOut = false;
+  std::string output;
+  // Lines of stderr, they are written to the log too
+  std::string errorOutput;
+
+  bool IsSuccess() const
+  {
+    return isStarted && !isTimedOut && signal == 0 && exitCode == 0;
+  }
+
+  std::string ToString() const;
+};
+
+/**
+ * @brief Starts processes without shell and watches all of them
+ * in one epoll loop: stdout and stderr lines are written to the log
+ * as soon as they are read, processes are terminated after timeout
+ * and their exit statuses are returned as futures.
+ */
+class ProcessRunner
+{
+public:
+  ProcessRunner();
+
+  ~ProcessRunner();
+
+  std::future<ProcessResult> Start(ProcessOptions const & options);
+
+  ProcessResult Run(ProcessOptions const & options);
+
+protected:
+  using Clock = std::chrono::steady_clock;
+
+  struct Process
+  {
+    pid_t pid = 0;
+    std::string name;
+    bool isOutputCaptured = false;
+    std::function<bool(char const * data, size_t size)> outputConsumer;
+    int outputFd = -1;
+    int errorFd = -1;
+    int pidFd = -1;
+    std::string outputLine;
+    std::string errorLine;
+    Clock::time_point deadline = Clock::time_point::max();
+    Clock::time_point killDeadline = Clock::time_point::max();
+    ProcessResult result;
+    std::promise<ProcessResult> promise;
+  };
+
+  int m_epollFd;
+  int m_wakeFd;
+  bool m_isStopped = false;
+  std::map<pid_t, std::unique_ptr<Process>> m_processes;
+  std::mutex m_mutex;
+  std::thread m_loop;
+
+  void Loop();
+
+  void Wake() const;
+
+  void ReadOutput(Process & process, int & fd, bool isError);
+
+  static void WriteLines(Process & process, std::string & buffer, bool isError, bool isFinal);
+
+  bool Reap(Process & process);
+
+  void CloseFd(int & fd);
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,113 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "repository_index.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <sc-memory/sc_debug.hpp>
+
+#include "hasher.hpp"
+
+namespace componentUtils
+{
+
+std::string const RepositoryIndex::ENTRY_HEADER = "@specification ";
+
+/**
+ * @brief Read and parse index file
+ * @param indexPath path to index file
+ * @return false if file can't be read
+ */
+bool RepositoryIndex::Load(std::string const & indexPath)
+{
+  std::ifstream indexFile(indexPath, std::ios::binary);
+  if (!indexFile.is_open())
+    return false;
+
+  std::string const indexContent{std::istreambuf_iterator<char>(indexFile), std::istreambuf_iterator<char>()};
+  Parse(indexContent);
+  return true;
+}
+
+/**
+ * @brief Split index content into specifications. Entries with
+ * content that doesn't match their hash are skipped.
+ * @param indexContent content of index file
+ * @return Count of correct entries
+ */
+size_t RepositoryIndex::Parse(std::string const & indexContent)
+{
+  m_entries.clear();
+
+  std::string systemIdtf;
+  RepositoryIndexEntry entry;
+  bool isEntryStarted = false;
+
+  std::istringstream indexStream(indexContent);
+  std::string line;
+  while (std::getline(indexStream, line))
+  {
+    if (line.compare(0, ENTRY_HEADER.size(), ENTRY_HEADER) == 0)
+    {
+      if (isEntryStarted)
+        AddEntry(systemIdtf, entry);
+
+      std::istringstream headerStream(line.substr(ENTRY_HEADER.size()));
+      systemIdtf.clear();
+      entry = {};
+      headerStream >> systemIdtf >> entry.hash;
+      isEntryStarted = true;
+    }
+    else if (isEntryStarted)
+      entry.content += line + "\n";
+  }
+
+  if (isEntryStarted)
+    AddEntry(systemIdtf, entry);
+
+  return m_entries.size();
+}
+
+bool RepositoryIndex::Find(std::string const & systemIdtf, RepositoryIndexEntry & entry) const
+{
+  auto const & it = m_entries.find(systemIdtf);
+  if (it == m_entries.cend())
+    return false;
+
+  entry = it->second;
+  return true;
+}
+
+/**
+ * @brief Make index entry for specification, it is used to publish index
+ * @param systemIdtf system identifier of specification
+ * @param content content of specification.scs file
+ * @return Text of index entry
+ */
+std::string RepositoryIndex::MakeEntry(std::string const & systemIdtf, std::string const & content)
+{
+  std::string entryContent = content;
+  if (!entryContent.empty() && entryContent.back() != '\n')
+    entryContent += "\n";
+
+  return ENTRY_HEADER + systemIdtf + " " + Hasher::GetStringHash(entryContent) + "\n" + entryContent;
+}
+
+void RepositoryIndex::AddEntry(std::string const & systemIdtf, RepositoryIndexEntry const & entry)
+{
+  if (systemIdtf.empty() || Hasher::GetStringHash(entry.content) != entry.hash)
+  {
+    SC_LOG_WARNING("RepositoryIndex: Entry \"" + systemIdtf + "\" is damaged and skipped");
+    return;
+  }
+
+  m_entries[systemIdtf] = entry;
+}
+
+}  // namespace componentUtils
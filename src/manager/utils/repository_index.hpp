@@ -0,0 +1,50 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace componentUtils
+{
+
+struct RepositoryIndexEntry
+{
+  std::string hash;
+  std::string content;
+};
+
+/**
+ * @brief Index of repository that contains all its components specifications
+ * in one file. Each specification starts with header line
+ * `@specification <system_idtf> <sha256 of content>` and lasts until the next header.
+ */
+class RepositoryIndex
+{
+public:
+  bool Load(std::string const & indexPath);
+
+  size_t Parse(std::string const & indexContent);
+
+  bool Find(std::string const & systemIdtf, RepositoryIndexEntry & entry) const;
+
+  size_t GetSize() const
+  {
+    return m_entries.size();
+  }
+
+  static std::string MakeEntry(std::string const & systemIdtf, std::string const & content);
+
+  static std::string const ENTRY_HEADER;
+
+protected:
+  std::map<std::string, RepositoryIndexEntry> m_entries;
+
+  void AddEntry(std::string const & systemIdtf, RepositoryIndexEntry const & entry);
+};
+
+}  // namespace componentUtils
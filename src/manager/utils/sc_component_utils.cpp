@@ -4,18 +4,41 @@
  * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
  */
 
-#include <dirent.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <unordered_map>
 #include <sys/stat.h>
 
 #include <sc-memory/sc_addr.hpp>
 #include <sc-memory/sc_type.hpp>
 #include <sc-memory/sc_iterator.hpp>
-#include <sc-builder/src/scs_loader.hpp>
+#include <sc-memory/sc_scs_helper.hpp>
+#include <sc-memory/scs/scs_parser.hpp>
 #include <sc-agents-common/utils/IteratorUtils.hpp>
 #include <sc-agents-common/utils/CommonUtils.hpp>
+#include "src/manager/commands/command_init/constants/command_init_constants.hpp"
 #include "src/manager/commands/keynodes/ScComponentManagerKeynodes.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
+#include "src/manager/utils/scs_batch_loader.hpp"
 #include "sc_component_utils.hpp"
 
+namespace
+{
+// Files referred from loaded scs texts aren't loaded, as ScsLoader does
+class EmptyScsFileInterface : public SCsFileInterface
+{
+public:
+  ScStreamPtr GetFileContent(std::string const & /* fileURL */) override
+  {
+    return {};
+  }
+};
+}  // namespace
+
 namespace componentUtils
 {
 
@@ -100,7 +123,9 @@ ScAddr SearchUtils::GetComponentInstallationMethod(ScMemoryContext * context, Sc
 }
 
 /**
- * @brief Get vector of ScLinks with specification address.
+ * @brief Get vector of ScLinks with specification addresses.
+ * Links of all alternative addresses are returned, links of
+ * the first address of alternative addresses tuple go first.
  * @param context current sc-memory context
  * @param componentSpecificationAddr sc-addr of specification node
  * @return Vector of sc-addr for sc-links which contain url address,
@@ -129,16 +154,21 @@ ScAddrVector SearchUtils::GetSpecificationAddress(ScMemoryContext * context, ScA
     SC_THROW_EXCEPTION(utils::ExceptionAssert, "Alternative addresses set is empty");
   }
 
-  ScAddr specificationAddressAddr = utils::IteratorUtils::getFirstFromSet(context, alternativeAddressesSet, true);
+  ScAddrVector specificationAddressesAddrs =
+      utils::IteratorUtils::getAllWithType(context, alternativeAddressesSet, ScType::NodeConst);
+  ScAddr const & firstAddressAddr = utils::IteratorUtils::getFirstFromSet(context, alternativeAddressesSet, true);
+  auto const & firstAddressIt =
+      std::find(specificationAddressesAddrs.begin(), specificationAddressesAddrs.end(), firstAddressAddr);
+  if (firstAddressAddr.IsValid() && firstAddressIt != specificationAddressesAddrs.end())
+    std::rotate(specificationAddressesAddrs.begin(), firstAddressIt, firstAddressIt + 1);
 
-  if (!specificationAddressAddr.IsValid())
+  for (ScAddr const & specificationAddressAddr : specificationAddressesAddrs)
   {
-    specificationAddressAddr = utils::IteratorUtils::getAnyFromSet(context, alternativeAddressesSet);
+    ScAddrVector const & addressLinks =
+        utils::IteratorUtils::getAllWithType(context, specificationAddressAddr, ScType::LinkConst);
+    specificationAddressLinks.insert(specificationAddressLinks.cend(), addressLinks.cbegin(), addressLinks.cend());
   }
 
-  specificationAddressLinks =
-      utils::IteratorUtils::getAllWithType(context, specificationAddressAddr, ScType::LinkConst);
-
   if (specificationAddressLinks.empty())
   {
     SC_THROW_EXCEPTION(utils::ExceptionAssert, "No sc-links connected with address node");
@@ -147,6 +177,42 @@ ScAddrVector SearchUtils::GetSpecificationAddress(ScMemoryContext * context, ScA
   return specificationAddressLinks;
 };
 
+/**
+ * @brief Get expected checksum of files downloaded from address.
+ * Checksum is sha256 in hex, optional `sha256:` prefix is removed.
+ * @param context current sc-memory context
+ * @param addressLinkAddr sc-addr of sc-link with url address
+ * @return Checksum in lower case, return empty string if address has no checksum
+ */
+std::string SearchUtils::GetAddressChecksum(ScMemoryContext * context, ScAddr const & addressLinkAddr)
+{
+  std::string const CHECKSUM_PREFIX = "sha256:";
+
+  ScIterator5Ptr const & checksumIterator = context->Iterator5(
+      addressLinkAddr,
+      ScType::EdgeDCommonConst,
+      ScType::LinkConst,
+      ScType::EdgeAccessConstPosPerm,
+      keynodes::ScComponentManagerKeynodes::nrel_checksum);
+
+  if (!checksumIterator->Next())
+    return "";
+
+  std::string checksum;
+  context->GetLinkContent(checksumIterator->Get(2), checksum);
+
+  size_t const begin = checksum.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos)
+    return "";
+  checksum = checksum.substr(begin, checksum.find_last_not_of(" \t\r\n") - begin + 1);
+  std::transform(checksum.begin(), checksum.end(), checksum.begin(), ::tolower);
+
+  if (checksum.rfind(CHECKSUM_PREFIX, 0) == 0)
+    checksum.erase(0, CHECKSUM_PREFIX.size());
+
+  return checksum;
+}
+
 /**
  * @brief Get sc-addr of sc-link with repository address.
  * @param context current sc-memory context
@@ -203,6 +269,75 @@ bool InstallUtils::IsReusable(ScMemoryContext * context, ScAddr const & componen
   return result;
 }
 
+/**
+ * @brief Get components marked for installation
+ * @param context current sc-memory context
+ * @return Sorted system identifiers of elements of concept_need_to_install
+ */
+std::vector<std::string> SearchUtils::GetNeedToInstallComponents(ScMemoryContext * context)
+{
+  ScIterator3Ptr const & componentsIterator = context->Iterator3(
+      keynodes::ScComponentManagerKeynodes::concept_need_to_install, ScType::EdgeAccessConstPosPerm, ScType::NodeConst);
+
+  std::set<std::string> components;
+  while (componentsIterator->Next())
+  {
+    std::string const componentIdtf = context->HelperGetSystemIdtf(componentsIterator->Get(2));
+    if (componentIdtf.empty())
+      SC_LOG_WARNING("Component to install without system identifier is skipped");
+    else
+      components.insert(componentIdtf);
+  }
+
+  return {components.cbegin(), components.cend()};
+}
+
+/**
+ * @brief Get glob patterns of component files. Each sc-link may contain
+ * several patterns separated by `;`.
+ * @param context current sc-memory context
+ * @param componentAddr sc-addr of component
+ * @param relationAddr nrel_included_files or nrel_excluded_files
+ * @return Patterns of paths relative to component directory
+ */
+std::vector<std::string> SearchUtils::GetComponentFilesPatterns(
+    ScMemoryContext * context,
+    ScAddr const & componentAddr,
+    ScAddr const & relationAddr)
+{
+  std::string const WHITESPACES = " \t\r\n";
+
+  ScIterator5Ptr const & patternsIterator = context->Iterator5(
+      componentAddr, ScType::EdgeDCommonConst, ScType::LinkConst, ScType::EdgeAccessConstPosPerm, relationAddr);
+
+  std::vector<std::string> patterns;
+  while (patternsIterator->Next())
+  {
+    std::string patternsContent;
+    context->GetLinkContent(patternsIterator->Get(2), patternsContent);
+
+    std::istringstream patternsStream(patternsContent);
+    std::string pattern;
+    while (std::getline(patternsStream, pattern, ';'))
+    {
+      size_t const begin = pattern.find_first_not_of(WHITESPACES);
+      if (begin == std::string::npos)
+        continue;
+
+      pattern = pattern.substr(begin, pattern.find_last_not_of(WHITESPACES) - begin + 1);
+      // Patterns are relative to component directory
+      while (pattern.rfind("./", 0) == 0)
+        pattern.erase(0, 2);
+      if (!pattern.empty() && pattern.back() == '/')
+        pattern.pop_back();
+      if (!pattern.empty())
+        patterns.push_back(pattern);
+    }
+  }
+
+  return patterns;
+}
+
 /**
  * Get installation scripts from component
  * @param context current sc-memory context
@@ -218,14 +353,14 @@ std::vector<std::string> InstallUtils::GetInstallScripts(ScMemoryContext * conte
       ScType::EdgeAccessConstPosPerm,
       keynodes::ScComponentManagerKeynodes::nrel_installation_script);
 
-  // TODO: bug: in kb folder there are 2 specifications for one rep, so all links duplicated
+  // Component can be described by several specifications, so the same script can be linked several times
   std::vector<std::string> scripts;
   while (installScriptsIterator->Next())
   {
     std::string script;
     const ScAddr & scriptAddrs = installScriptsIterator->Get(2);
     context->GetLinkContent(scriptAddrs, script);
-    if (!script.empty())
+    if (!script.empty() && std::find(scripts.cbegin(), scripts.cend(), script) == scripts.cend())
     {
       scripts.push_back(script);
     }
@@ -287,30 +422,381 @@ std::string InstallUtils::GetComponentDirName(
 }
 
 /**
- * Load all .scs files in directory
+ * @brief Normalize url to compare addresses of the same source.
+ * Scheme and host are lowercased, "www." prefix, trailing slashes
+ * and ".git" suffix are removed. GitHub paths are case insensitive,
+ * so they are lowercased too.
+ * @param url url address
+ * @return Normalized url
+ */
+std::string UrlUtils::NormalizeUrl(std::string const & url)
+{
+  std::string const SCHEME_DELIMITER = "://";
+  std::string const WWW_PREFIX = "www.";
+  std::string const GIT_POSTFIX = ".git";
+  std::string const GITHUB_HOST = "github.com";
+
+  size_t const urlBegin = url.find_first_not_of(" \t\n");
+  if (urlBegin == std::string::npos)
+    return "";
+  size_t const urlEnd = url.find_last_not_of(" \t\n");
+  std::string normalizedUrl = url.substr(urlBegin, urlEnd - urlBegin + 1);
+
+  size_t const schemeEnd = normalizedUrl.find(SCHEME_DELIMITER);
+  size_t const hostBegin = schemeEnd == std::string::npos ? 0 : schemeEnd + SCHEME_DELIMITER.size();
+  size_t hostEnd = normalizedUrl.find('/', hostBegin);
+  if (hostEnd == std::string::npos)
+    hostEnd = normalizedUrl.size();
+
+  std::transform(normalizedUrl.begin(), normalizedUrl.begin() + hostEnd, normalizedUrl.begin(), ::tolower);
+  if (normalizedUrl.compare(hostBegin, WWW_PREFIX.size(), WWW_PREFIX) == 0)
+  {
+    normalizedUrl.erase(hostBegin, WWW_PREFIX.size());
+    hostEnd -= WWW_PREFIX.size();
+  }
+
+  if (normalizedUrl.compare(hostBegin, hostEnd - hostBegin, GITHUB_HOST) == 0)
+    std::transform(normalizedUrl.begin(), normalizedUrl.end(), normalizedUrl.begin(), ::tolower);
+
+  while (normalizedUrl.size() > hostEnd && normalizedUrl.back() == '/')
+    normalizedUrl.pop_back();
+
+  if (normalizedUrl.size() > hostEnd + GIT_POSTFIX.size() &&
+      normalizedUrl.compare(normalizedUrl.size() - GIT_POSTFIX.size(), GIT_POSTFIX.size(), GIT_POSTFIX) == 0)
+    normalizedUrl.erase(normalizedUrl.size() - GIT_POSTFIX.size());
+
+  return normalizedUrl;
+}
+
+/**
+ * @brief Get host of url, port is a part of host
+ * @param url url
+ * @return Lowercase host, return empty string if url has no host
+ */
+std::string UrlUtils::GetHost(std::string const & url)
+{
+  std::string const SCHEME_DELIMITER = "://";
+
+  std::string const normalizedUrl = NormalizeUrl(url);
+  size_t const schemeEnd = normalizedUrl.find(SCHEME_DELIMITER);
+  if (schemeEnd == std::string::npos)
+    return "";
+
+  size_t const hostBegin = schemeEnd + SCHEME_DELIMITER.size();
+  size_t hostEnd = normalizedUrl.find('/', hostBegin);
+  if (hostEnd == std::string::npos)
+    hostEnd = normalizedUrl.size();
+
+  std::string host = normalizedUrl.substr(hostBegin, hostEnd - hostBegin);
+  size_t const userInfoEnd = host.rfind('@');
+  if (userInfoEnd != std::string::npos)
+    host.erase(0, userInfoEnd + 1);
+
+  return host;
+}
+
+/**
+ * @brief Rewrite remote url to directory of local mirror.
+ * Part of url after matched prefix is a path in mirror root.
+ * @param url url of source
+ * @param mirrorRoot directory of local mirror
+ * @param mirrorPrefixes prefixes of urls that are mirrored
+ * @return `file://` url of mirrored source, return empty string if url isn't mirrored
+ */
+std::string UrlUtils::GetMirrorUrl(
+    std::string const & url,
+    std::string const & mirrorRoot,
+    std::vector<std::string> const & mirrorPrefixes)
+{
+  std::string const FILE_SCHEME = "file://";
+  std::string const GIT_POSTFIX = ".git";
+
+  if (mirrorRoot.empty())
+    return "";
+
+  size_t const urlBegin = url.find_first_not_of(" \t\n");
+  if (urlBegin == std::string::npos)
+    return "";
+  size_t const urlEnd = url.find_last_not_of(" \t\n");
+  std::string const trimmedUrl = url.substr(urlBegin, urlEnd - urlBegin + 1);
+
+  for (std::string const & prefix : mirrorPrefixes)
+  {
+    if (prefix.empty() || trimmedUrl.rfind(prefix, 0) != 0)
+      continue;
+
+    std::string path = trimmedUrl.substr(prefix.size());
+    while (!path.empty() && path.back() == '/')
+      path.pop_back();
+    if (path.size() > GIT_POSTFIX.size() &&
+        path.compare(path.size() - GIT_POSTFIX.size(), GIT_POSTFIX.size(), GIT_POSTFIX) == 0)
+      path.erase(path.size() - GIT_POSTFIX.size());
+    path.erase(0, path.find_first_not_of('/'));
+
+    std::string root = mirrorRoot;
+    while (root.size() > 1 && root.back() == '/')
+      root.pop_back();
+
+    return FILE_SCHEME + root + (path.empty() ? "" : "/" + path);
+  }
+
+  return "";
+}
+
+/**
+ * Get paths of .scs files in directory and its subdirectories
+ * @param dirPath directory path
+ * @param includePatterns glob patterns of paths relative to directory, all files are included if it is empty
+ * @param excludePatterns glob patterns of paths relative to directory, they take precedence over included ones
+ * @return vector of sorted .scs files paths
+ */
+std::vector<std::string> LoadUtils::GetScsFilesInDir(
+    std::string const & dirPath,
+    std::vector<std::string> const & includePatterns,
+    std::vector<std::string> const & excludePatterns)
+{
+  std::vector<std::string> filesPaths = FileUtils::GetFilesInDirectory(dirPath, SpecificationConstants::SCS_EXTENSION);
+  filesPaths.erase(
+      std::remove_if(
+          filesPaths.begin(),
+          filesPaths.end(),
+          [&dirPath, &includePatterns, &excludePatterns](std::string const & filePath) {
+            return !IsScsFileIncluded(filePath.substr(dirPath.size() + 1), includePatterns, excludePatterns);
+          }),
+      filesPaths.end());
+  return filesPaths;
+}
+
+/**
+ * Check if .scs file is matched by include and exclude patterns
+ * @param relativePath path of file relative to component directory
+ * @param includePatterns glob patterns, all files are included if it is empty
+ * @param excludePatterns glob patterns, they take precedence over included ones
+ * @return true if file should be loaded
+ */
+bool LoadUtils::IsScsFileIncluded(
+    std::string const & relativePath,
+    std::vector<std::string> const & includePatterns,
+    std::vector<std::string> const & excludePatterns)
+{
+  return (includePatterns.empty() || FileUtils::IsPathMatched(relativePath, includePatterns)) &&
+         !FileUtils::IsPathMatched(relativePath, excludePatterns);
+}
+
+/**
+ * Load all .scs files in directory and its subdirectories
  * @param context current sc-memory context
  * @param dirPath directory path
+ * @param cachePath directory of parsed files cache, files are always parsed if it is empty
+ */
+bool LoadUtils::LoadScsFilesInDir(ScMemoryContext * context, std::string const & dirPath, std::string const & cachePath)
+{
+  return LoadScsFiles(context, GetScsFilesInDir(dirPath), cachePath);
+}
+
+/**
+ * Load .scs files. Files are parsed in parallel and generated by the calling thread
+ * @param context current sc-memory context
+ * @param filesPaths paths of .scs files
+ * @param cachePath directory of parsed files cache, files are always parsed if it is empty
+ * @return true if all files are loaded
  */
-bool LoadUtils::LoadScsFilesInDir(ScMemoryContext * context, std::string const & dirPath)
+bool LoadUtils::LoadScsFiles(
+    ScMemoryContext * context,
+    std::vector<std::string> const & filesPaths,
+    std::string const & cachePath)
 {
-  bool result = false;
-  ScsLoader loader;
-  DIR * dir;
-  struct dirent * diread;
-  if ((dir = opendir(dirPath.c_str())) != nullptr)
+  ScsBatchLoader loader(cachePath);
+  return loader.Load(context, filesPaths);
+}
+
+/**
+ * Read content of .scs file
+ * @param filePath path to file
+ * @param scsText read content
+ * @return true if file is read
+ */
+bool LoadUtils::ReadScsFile(std::string const & filePath, std::string & scsText)
+{
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  scsText.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+/**
+ * Check syntax of scs text without changing knowledge base.
+ * It doesn't use sc-memory, so it can be called from any thread
+ * @param scsText text in SCs language
+ * @param error description of syntax error
+ * @return true if text is correct
+ */
+bool LoadUtils::ValidateScsText(std::string const & scsText, std::string & error)
+{
+  scs::Parser parser;
+  if (parser.Parse(scsText))
+    return true;
+
+  error = parser.GetParseError();
+  return false;
+}
+
+/**
+ * Parse scs text into elements that are generated without parsing again.
+ * It doesn't use sc-memory, so it can be called from any thread. Text with
+ * constructions that elements can't represent is kept to be generated by SCs helper
+ * @param scsText text in SCs language
+ * @param triples parsed elements of text
+ * @param error description of syntax error
+ * @return true if text is correct
+ */
+bool LoadUtils::ParseScsText(std::string const & scsText, ScsTriples & triples, std::string & error)
+{
+  scs::Parser parser;
+  if (!parser.Parse(scsText))
   {
-    while ((diread = readdir(dir)) != nullptr)
+    error = parser.GetParseError();
+    return false;
+  }
+
+  triples.elements.clear();
+  triples.scsText.clear();
+  std::unordered_map<std::string, size_t> elementsIndices;
+  bool isRepresented = true;
+
+  auto const & addElement = [&triples, &elementsIndices, &isRepresented](scs::ParsedElement const & element) {
+    auto const & it = elementsIndices.find(element.GetIdtf());
+    if (it != elementsIndices.cend())
+      return it->second;
+
+    ScType const & type = element.GetType();
+    if (type.IsEdge() || element.IsURL() || element.GetVisibility() == scs::Visibility::Global)
     {
-      std::string filename = diread->d_name;
-      if (filename.rfind(".scs") != std::string::npos)
-      {
-        loader.loadScsFile(*context, dirPath + "/" + filename);  // TODO: need to fix in sc-machine
-        result = true;                                           // while not fixed
-      }
+      isRepresented = false;
+      return size_t(0);
     }
-    closedir(dir);
+
+    ScsElement scsElement;
+    scsElement.type = *type;
+    if (element.GetVisibility() == scs::Visibility::System)
+      scsElement.systemIdtf = element.GetIdtf();
+    if (type.IsLink())
+      scsElement.content = element.GetValue();
+
+    triples.elements.push_back(std::move(scsElement));
+    elementsIndices[element.GetIdtf()] = triples.elements.size() - 1;
+    return triples.elements.size() - 1;
+  };
+
+  for (scs::ParsedTriple const & triple : parser.GetParsedTriples())
+  {
+    size_t const sourceIndex = addElement(parser.GetParsedElement(triple.m_source));
+    size_t const targetIndex = addElement(parser.GetParsedElement(triple.m_target));
+    if (!isRepresented)
+      break;
+
+    scs::ParsedElement const & edge = parser.GetParsedElement(triple.m_edge);
+    ScsElement edgeElement;
+    edgeElement.type = *edge.GetType();
+    edgeElement.sourceIndex = sourceIndex;
+    edgeElement.targetIndex = targetIndex;
+    triples.elements.push_back(std::move(edgeElement));
+    elementsIndices[edge.GetIdtf()] = triples.elements.size() - 1;
   }
-  return result;
+
+  parser.ForEachParsedElement([&addElement](scs::ParsedElement const & element) {
+    if (!element.GetType().IsEdge() && !scs::TypeResolver::IsKeynodeType(element.GetIdtf()))
+      addElement(element);
+  });
+
+  if (!isRepresented)
+  {
+    triples.elements.clear();
+    triples.scsText = scsText;
+  }
+
+  return true;
+}
+
+/**
+ * Read and parse .scs file. Parsed form is taken from cache by hash of text,
+ * so unchanged text isn't parsed again
+ * @param filePath path to file
+ * @param cache cache of parsed texts
+ * @param triples parsed elements of text
+ * @param error description of read or syntax error
+ * @return true if file is read and its text is correct
+ */
+bool LoadUtils::ParseScsFile(
+    std::string const & filePath,
+    ScsCache const & cache,
+    ScsTriples & triples,
+    std::string & error)
+{
+  std::string scsText;
+  if (!ReadScsFile(filePath, scsText))
+  {
+    error = "Can't read file";
+    return false;
+  }
+
+  triples.filePath = filePath;
+  std::string const hash = Hasher::GetStringHash(scsText);
+  triples.hash = hash;
+  if (cache.Find(hash, triples))
+    return true;
+
+  if (!ParseScsText(scsText, triples, error))
+    return false;
+
+  cache.Store(hash, triples);
+  return true;
+}
+
+/**
+ * Generate scs text in knowledge base
+ * @param context current sc-memory context
+ * @param scsText text in SCs language
+ * @return true if text is loaded
+ */
+bool LoadUtils::LoadScsText(ScMemoryContext * context, std::string const & scsText)
+{
+  SCsHelper helper(*context, std::make_shared<EmptyScsFileInterface>());
+  if (helper.GenerateBySCsText(scsText))
+    return true;
+
+  SC_LOG_WARNING("LoadUtils: " + helper.GetLastError());
+  return false;
+}
+
+/**
+ * Check if scs text with hash is already loaded into sc-memory
+ * @param context current sc-memory context
+ * @param hash SHA-256 of scs text
+ * @return true if sc-link with hash belongs to concept_loaded_scs_text
+ */
+bool LoadUtils::IsScsTextLoaded(ScMemoryContext * context, std::string const & hash)
+{
+  ScAddrVector const & linksAddrs = context->FindLinksByContent(hash);
+  return std::any_of(linksAddrs.cbegin(), linksAddrs.cend(), [context](ScAddr const & linkAddr) {
+    return context->HelperCheckEdge(
+        keynodes::ScComponentManagerKeynodes::concept_loaded_scs_text, linkAddr, ScType::EdgeAccessConstPosPerm);
+  });
+}
+
+/**
+ * Remember in sc-memory that scs text with hash is loaded, so it isn't loaded again
+ * @param context current sc-memory context
+ * @param hash SHA-256 of scs text
+ */
+void LoadUtils::MarkScsTextLoaded(ScMemoryContext * context, std::string const & hash)
+{
+  ScAddr const & hashLinkAddr = context->CreateLink(ScType::LinkConst);
+  context->SetLinkContent(hashLinkAddr, hash);
+  context->CreateEdge(
+      ScType::EdgeAccessConstPosPerm, keynodes::ScComponentManagerKeynodes::concept_loaded_scs_text, hashLinkAddr);
 }
 
 }  // namespace componentUtils
@@ -8,6 +8,9 @@
 
 #include <sc-memory/sc_memory.hpp>
 
+#include "src/manager/utils/scs_cache.hpp"
+#include "src/manager/utils/scs_triples.hpp"
+
 namespace componentUtils
 {
 
@@ -22,7 +25,16 @@ public:
 
   static ScAddrVector GetSpecificationAddress(ScMemoryContext * context, ScAddr const & componentSpecificationAddr);
 
+  static std::string GetAddressChecksum(ScMemoryContext * context, ScAddr const & addressLinkAddr);
+
   static ScAddr GetRepositoryAddress(ScMemoryContext * context, ScAddr const & repositoryAddr);
+
+  static std::vector<std::string> GetComponentFilesPatterns(
+      ScMemoryContext * context,
+      ScAddr const & componentAddr,
+      ScAddr const & relationAddr);
+
+  static std::vector<std::string> GetNeedToInstallComponents(ScMemoryContext * context);
 };
 
 class InstallUtils
@@ -42,10 +54,59 @@ public:
   static std::vector<std::string> GetInstallScripts(ScMemoryContext * context, ScAddr const & componentAddr);
 };
 
+class UrlUtils
+{
+public:
+  static std::string NormalizeUrl(std::string const & url);
+
+  static std::string GetHost(std::string const & url);
+
+  static std::string GetMirrorUrl(
+      std::string const & url,
+      std::string const & mirrorRoot,
+      std::vector<std::string> const & mirrorPrefixes);
+};
+
 class LoadUtils
 {
 public:
-  static bool LoadScsFilesInDir(ScMemoryContext * context, std::string const & dirPath);
+  static std::vector<std::string> GetScsFilesInDir(
+      std::string const & dirPath,
+      std::vector<std::string> const & includePatterns = {},
+      std::vector<std::string> const & excludePatterns = {});
+
+  static bool IsScsFileIncluded(
+      std::string const & relativePath,
+      std::vector<std::string> const & includePatterns,
+      std::vector<std::string> const & excludePatterns);
+
+  static bool LoadScsFilesInDir(
+      ScMemoryContext * context,
+      std::string const & dirPath,
+      std::string const & cachePath = "");
+
+  static bool LoadScsFiles(
+      ScMemoryContext * context,
+      std::vector<std::string> const & filesPaths,
+      std::string const & cachePath = "");
+
+  static bool ReadScsFile(std::string const & filePath, std::string & scsText);
+
+  static bool ValidateScsText(std::string const & scsText, std::string & error);
+
+  static bool ParseScsText(std::string const & scsText, ScsTriples & triples, std::string & error);
+
+  static bool ParseScsFile(
+      std::string const & filePath,
+      ScsCache const & cache,
+      ScsTriples & triples,
+      std::string & error);
+
+  static bool LoadScsText(ScMemoryContext * context, std::string const & scsText);
+
+  static bool IsScsTextLoaded(ScMemoryContext * context, std::string const & hash);
+
+  static void MarkScsTextLoaded(ScMemoryContext * context, std::string const & hash);
 };
 
 }  // namespace componentUtils
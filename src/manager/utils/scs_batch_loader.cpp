@@ -0,0 +1,212 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scs_batch_loader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+#include <sc-memory/sc_debug.hpp>
+
+#include "src/manager/utils/blocking_queue.hpp"
+#include "src/manager/utils/sc_component_utils.hpp"
+#include "src/manager/utils/thread_pool.hpp"
+
+namespace componentUtils
+{
+
+ScsBatchLoader::ScsBatchLoader(std::string cachePath, size_t threadsCount, size_t batchSize)
+  : m_cache(std::move(cachePath))
+  , m_threadsCount(std::max<size_t>(threadsCount, 1))
+  , m_batchSize(std::max<size_t>(batchSize, 1))
+{
+}
+
+/**
+ * @brief Load .scs files. Files are parsed in parallel and generated in batches
+ * in the order they are parsed, so order of files isn't kept.
+ * @param context sc-memory context of the calling thread
+ * @param filesPaths paths of .scs files
+ * @return true if all files are loaded
+ */
+bool ScsBatchLoader::Load(ScMemoryContext * context, std::vector<std::string> const & filesPaths)
+{
+  if (filesPaths.empty())
+    return true;
+
+  BlockingQueue<ScsTriples> parsedFiles(kQueueCapacity);
+  std::atomic<size_t> failedFilesCount{0};
+  ThreadPool parsePool(std::min(m_threadsCount, filesPaths.size()));
+  for (std::string const & filePath : filesPaths)
+  {
+    parsePool.Submit([this, &parsedFiles, &failedFilesCount, filePath]() {
+      ScsTriples triples;
+      std::string error;
+      bool isParsed = false;
+      try
+      {
+        isParsed = LoadUtils::ParseScsFile(filePath, m_cache, triples, error);
+      }
+      catch (std::exception const & exception)
+      {
+        error = exception.what();
+      }
+
+      if (!isParsed)
+      {
+        SC_LOG_WARNING("ScsBatchLoader: \"" + filePath + "\" is skipped. " + error);
+        triples = ScsTriples();
+        ++failedFilesCount;
+      }
+
+      // Each file is pushed, so writer knows when all files are parsed
+      triples.filePath = filePath;
+      parsedFiles.Push(std::move(triples));
+    });
+  }
+
+  bool isLoaded = true;
+  size_t batchesCount = 0;
+  size_t elementsCount = 0;
+  std::vector<ScsTriples> batch;
+  size_t batchElementsCount = 0;
+  ScsTriples triples;
+  for (size_t filesCount = 1; filesCount <= filesPaths.size() && parsedFiles.Pop(triples); ++filesCount)
+  {
+    batchElementsCount += triples.elements.size();
+    batch.push_back(std::move(triples));
+    if (batchElementsCount < m_batchSize && filesCount < filesPaths.size())
+      continue;
+
+    isLoaded = Apply(context, batch) && isLoaded;
+    ++batchesCount;
+    elementsCount += batchElementsCount;
+    batch.clear();
+    batchElementsCount = 0;
+  }
+
+  SC_LOG_DEBUG(
+      "ScsBatchLoader: " + std::to_string(filesPaths.size()) + " files, " + std::to_string(elementsCount) +
+      " elements are loaded in " + std::to_string(batchesCount) + " batches by " +
+      std::to_string(parsePool.GetThreadsCount()) + " parse workers");
+  return isLoaded && failedFilesCount == 0;
+}
+
+/**
+ * @brief Generate batch of parsed files in sc-memory. Files with hashes of already
+ * loaded texts are skipped, so the same text doesn't duplicate its sc-links and arcs.
+ * @param context current sc-memory context
+ * @param batch parsed files
+ * @return true if all files are generated
+ */
+bool ScsBatchLoader::Apply(ScMemoryContext * context, std::vector<ScsTriples> const & batch)
+{
+  bool isApplied = true;
+  std::unordered_map<std::string, ScAddr> systemAddrs;
+  std::unordered_set<std::string> batchHashes;
+  std::vector<ScAddr> addrs;
+  for (ScsTriples const & triples : batch)
+  {
+    if (!triples.hash.empty() &&
+        (!batchHashes.insert(triples.hash).second || LoadUtils::IsScsTextLoaded(context, triples.hash)))
+    {
+      SC_LOG_DEBUG("ScsBatchLoader: \"" + triples.filePath + "\" is already loaded");
+      continue;
+    }
+
+    bool const isFileApplied = ApplyFile(context, triples, addrs, systemAddrs);
+    if (isFileApplied && !triples.hash.empty())
+      LoadUtils::MarkScsTextLoaded(context, triples.hash);
+
+    isApplied = isFileApplied && isApplied;
+  }
+
+  return isApplied;
+}
+
+bool ScsBatchLoader::ApplyFile(
+    ScMemoryContext * context,
+    ScsTriples const & triples,
+    std::vector<ScAddr> & addrs,
+    std::unordered_map<std::string, ScAddr> & systemAddrs)
+{
+  if (!triples.scsText.empty())
+    return LoadUtils::LoadScsText(context, triples.scsText);
+
+  addrs.clear();
+  addrs.reserve(triples.elements.size());
+  try
+  {
+    for (ScsElement const & element : triples.elements)
+      addrs.push_back(GenerateElement(context, element, addrs, systemAddrs));
+  }
+  catch (utils::ScException const & exception)
+  {
+    SC_LOG_WARNING("ScsBatchLoader: \"" + triples.filePath + "\" isn't fully loaded. " + exception.Message());
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Find or create element. Element with system identifier is found
+ * in sc-memory once per batch, and its type is extended by parsed type.
+ * @param context current sc-memory context
+ * @param element parsed element
+ * @param addrs sc-addrs of previous elements of file
+ * @param systemAddrs sc-addrs of elements with system identifiers in batch
+ * @return Sc-addr of element
+ */
+ScAddr ScsBatchLoader::GenerateElement(
+    ScMemoryContext * context,
+    ScsElement const & element,
+    std::vector<ScAddr> const & addrs,
+    std::unordered_map<std::string, ScAddr> & systemAddrs)
+{
+  ScType const type(element.type);
+  if (type.IsEdge())
+  {
+    if (element.sourceIndex >= addrs.size() || element.targetIndex >= addrs.size())
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "Edge refers to element that isn't generated yet");
+
+    return context->CreateEdge(type, addrs[element.sourceIndex], addrs[element.targetIndex]);
+  }
+
+  if (element.systemIdtf.empty())
+    return CreateElement(context, element);
+
+  ScAddr & addr = systemAddrs[element.systemIdtf];
+  if (!addr.IsValid())
+    addr = context->HelperFindBySystemIdtf(element.systemIdtf);
+
+  if (!addr.IsValid())
+  {
+    addr = CreateElement(context, element);
+    context->HelperSetSystemIdtf(element.systemIdtf, addr);
+    return addr;
+  }
+
+  ScType const currentType = context->GetElementType(addr);
+  if (!type.IsUnknown() && type != currentType && currentType.CanExtendTo(type))
+    context->SetElementSubtype(addr, *type);
+
+  return addr;
+}
+
+ScAddr ScsBatchLoader::CreateElement(ScMemoryContext * context, ScsElement const & element)
+{
+  ScType const type(element.type);
+  if (!type.IsLink())
+    return context->CreateNode(type.IsUnknown() ? ScType::NodeConst : type);
+
+  ScAddr const linkAddr = context->CreateLink(type);
+  context->SetLinkContent(linkAddr, element.content);
+  return linkAddr;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,66 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sc-memory/sc_memory.hpp>
+
+#include "scs_cache.hpp"
+#include "scs_triples.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Loads .scs files into sc-memory. Files are read and parsed by pool of workers,
+ * and parsed files are generated in batches by the calling thread, so only one
+ * thread writes into sc-memory. Elements with system identifiers are resolved
+ * once per batch. Parsed files are taken from cache if their texts aren't changed.
+ * Hashes of loaded texts are kept in sc-memory, so the same text is loaded only once.
+ */
+class ScsBatchLoader
+{
+public:
+  explicit ScsBatchLoader(
+      std::string cachePath = "",
+      size_t threadsCount = std::thread::hardware_concurrency(),
+      size_t batchSize = kDefaultBatchSize);
+
+  bool Load(ScMemoryContext * context, std::vector<std::string> const & filesPaths);
+
+  static bool Apply(ScMemoryContext * context, std::vector<ScsTriples> const & batch);
+
+protected:
+  // Count of elements that are generated in one batch
+  static size_t constexpr kDefaultBatchSize = 65536;
+  // Count of parsed files that wait for writer
+  static size_t constexpr kQueueCapacity = 64;
+
+  ScsCache m_cache;
+  size_t m_threadsCount;
+  size_t m_batchSize;
+
+  static bool ApplyFile(
+      ScMemoryContext * context,
+      ScsTriples const & triples,
+      std::vector<ScAddr> & addrs,
+      std::unordered_map<std::string, ScAddr> & systemAddrs);
+
+  static ScAddr GenerateElement(
+      ScMemoryContext * context,
+      ScsElement const & element,
+      std::vector<ScAddr> const & addrs,
+      std::unordered_map<std::string, ScAddr> & systemAddrs);
+
+  static ScAddr CreateElement(ScMemoryContext * context, ScsElement const & element);
+};
+
+}  // namespace componentUtils
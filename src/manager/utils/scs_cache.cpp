@@ -0,0 +1,234 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scs_cache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include "sc-memory/sc_debug.hpp"
+
+namespace
+{
+template <class TValue>
+void WriteValue(std::string & data, TValue value)
+{
+  data.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+void WriteString(std::string & data, std::string const & value)
+{
+  WriteValue<uint64_t>(data, value.size());
+  data.append(value);
+}
+
+/**
+ * @brief Reader of blob that checks its bounds, so broken blob is treated as missing one.
+ */
+class BlobReader
+{
+public:
+  BlobReader(char const * data, size_t size)
+    : m_data(data)
+    , m_size(size)
+  {
+  }
+
+  template <class TValue>
+  bool ReadValue(TValue & value)
+  {
+    if (m_size - m_offset < sizeof(value))
+      return false;
+
+    std::memcpy(&value, m_data + m_offset, sizeof(value));
+    m_offset += sizeof(value);
+    return true;
+  }
+
+  bool ReadString(std::string & value)
+  {
+    uint64_t size;
+    if (!ReadValue(size) || m_size - m_offset < size)
+      return false;
+
+    value.assign(m_data + m_offset, size);
+    m_offset += size;
+    return true;
+  }
+
+  bool IsEnded() const
+  {
+    return m_offset == m_size;
+  }
+
+protected:
+  char const * m_data;
+  size_t m_size;
+  size_t m_offset = 0;
+};
+}  // namespace
+
+namespace componentUtils
+{
+
+ScsCache::ScsCache(std::string cachePath)
+  : m_cachePath(std::move(cachePath))
+{
+}
+
+/**
+ * @brief Read parsed form of text
+ * @param hash hash of text
+ * @param triples parsed form of text
+ * @return false if text isn't cached or its blob is broken
+ */
+bool ScsCache::Find(std::string const & hash, ScsTriples & triples) const
+{
+  if (m_cachePath.empty())
+    return false;
+
+  int const fd = open(GetBlobPath(hash).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  struct stat blobStat;
+  if (fstat(fd, &blobStat) != 0 || blobStat.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  size_t const size = static_cast<size_t>(blobStat.st_size);
+  void * data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  bool const isRead = Deserialize(static_cast<char const *>(data), size, triples);
+  munmap(data, size);
+  return isRead;
+}
+
+/**
+ * @brief Save parsed form of text. Blob is written into temporary file
+ * and renamed, so readers don't see partially written blob.
+ * @param hash hash of text
+ * @param triples parsed form of text
+ */
+void ScsCache::Store(std::string const & hash, ScsTriples const & triples) const
+{
+  if (m_cachePath.empty())
+    return;
+
+  std::string const blobPath = GetBlobPath(hash);
+  std::string const blobDirectory = blobPath.substr(0, blobPath.rfind('/'));
+  if (!sc_fs_mkdirs(blobDirectory.c_str()))
+    return;
+
+  std::string const temporaryPath =
+      blobPath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream blobFile(temporaryPath, std::ios::binary | std::ios::trunc);
+    blobFile << Serialize(triples);
+    if (!blobFile.good())
+    {
+      SC_LOG_WARNING("ScsCache: Can't write \"" + temporaryPath + "\"");
+      std::remove(temporaryPath.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(temporaryPath.c_str(), blobPath.c_str()) != 0)
+    std::remove(temporaryPath.c_str());
+}
+
+/**
+ * @brief Make blob of parsed text. Numbers are written in native byte order,
+ * because cache isn't moved between machines.
+ * @param triples parsed text
+ * @return Blob data
+ */
+std::string ScsCache::Serialize(ScsTriples const & triples)
+{
+  std::string data;
+  WriteValue(data, kMagic);
+  WriteValue(data, kVersion);
+  WriteString(data, triples.scsText);
+  WriteValue<uint64_t>(data, triples.elements.size());
+  for (ScsElement const & element : triples.elements)
+  {
+    WriteValue<uint16_t>(data, element.type);
+    WriteValue<uint64_t>(data, element.sourceIndex);
+    WriteValue<uint64_t>(data, element.targetIndex);
+    WriteString(data, element.systemIdtf);
+    WriteString(data, element.content);
+  }
+
+  return data;
+}
+
+/**
+ * @brief Read parsed text from blob
+ * @param data blob data
+ * @param size size of blob
+ * @param triples parsed text, path and hash of file aren't changed
+ * @return false if blob is broken or it has other version
+ */
+bool ScsCache::Deserialize(char const * data, size_t size, ScsTriples & triples)
+{
+  BlobReader reader(data, size);
+  uint32_t magic;
+  uint32_t version;
+  uint64_t elementsCount;
+  if (!reader.ReadValue(magic) || magic != kMagic || !reader.ReadValue(version) || version != kVersion ||
+      !reader.ReadString(triples.scsText) || !reader.ReadValue(elementsCount))
+    return false;
+
+  triples.elements.clear();
+  triples.elements.reserve(std::min<uint64_t>(elementsCount, size));
+  for (uint64_t i = 0; i < elementsCount; ++i)
+  {
+    ScsElement element;
+    uint16_t type;
+    uint64_t sourceIndex;
+    uint64_t targetIndex;
+    if (!reader.ReadValue(type) || !reader.ReadValue(sourceIndex) || !reader.ReadValue(targetIndex) ||
+        !reader.ReadString(element.systemIdtf) || !reader.ReadString(element.content))
+      return false;
+
+    // Edges can refer only to previous elements, indices of other elements are zero
+    if ((sourceIndex >= i && sourceIndex != 0) || (targetIndex >= i && targetIndex != 0))
+      return false;
+
+    element.type = type;
+    element.sourceIndex = sourceIndex;
+    element.targetIndex = targetIndex;
+    triples.elements.push_back(std::move(element));
+  }
+
+  return reader.IsEnded();
+}
+
+std::string ScsCache::GetBlobPath(std::string const & hash) const
+{
+  // Blobs are split by the first byte of hash, so directories don't become too big
+  return m_cachePath + "/" + hash.substr(0, 2) + "/" + hash;
+}
+
+}  // namespace componentUtils
@@ -0,0 +1,46 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "scs_triples.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Persisted parsed forms of .scs files. Each file is stored as binary blob
+ * named by hash of its text, so unchanged texts aren't parsed again after restart.
+ * Blobs are read through mmap. Cache with empty path doesn't store anything.
+ * All methods are thread safe.
+ */
+class ScsCache
+{
+public:
+  explicit ScsCache(std::string cachePath = "");
+
+  bool Find(std::string const & hash, ScsTriples & triples) const;
+
+  void Store(std::string const & hash, ScsTriples const & triples) const;
+
+  static std::string Serialize(ScsTriples const & triples);
+
+  static bool Deserialize(char const * data, size_t size, ScsTriples & triples);
+
+protected:
+  static uint32_t constexpr kMagic = 0x42534353;  // "SCSB"
+  // Blobs of other versions are parsed again and replaced
+  static uint32_t constexpr kVersion = 1;
+
+  std::string m_cachePath;
+
+  std::string GetBlobPath(std::string const & hash) const;
+};
+
+}  // namespace componentUtils
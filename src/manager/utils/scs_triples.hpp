@@ -0,0 +1,47 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <sc-memory/sc_type.hpp>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Element of parsed scs text. Edges refer to their ends by indices in elements of text.
+ */
+struct ScsElement
+{
+  sc_type type = 0;
+  // System identifier, it is empty for elements that are local in scs text
+  std::string systemIdtf;
+  // Content of sc-link
+  std::string content;
+  size_t sourceIndex = 0;
+  size_t targetIndex = 0;
+};
+
+/**
+ * @brief Intermediate representation of scs text. It is made without sc-memory,
+ * so texts are parsed in parallel and then generated by one writer.
+ * Ends of each edge go before it in elements.
+ */
+struct ScsTriples
+{
+  std::string filePath;
+  // SHA-256 of text, text with the same hash is loaded into sc-memory only once
+  std::string hash;
+  std::vector<ScsElement> elements;
+  // Text that is generated by SCs helper. It is kept only if text has
+  // constructions that can't be represented by elements, e.g. file urls
+  std::string scsText;
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,31 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "specifications_manifest.hpp"
+
+namespace componentUtils
+{
+
+SpecificationsManifest::SpecificationsManifest(std::string manifestPath)
+  : PersistentStore(std::move(manifestPath))
+{
+}
+
+bool SpecificationsManifest::ParseEntry(std::vector<std::string> const & fields, ManifestEntry & entry) const
+{
+  if (fields.size() != 3)
+    return false;
+
+  entry = {fields[0], fields[1], fields[2]};
+  return true;
+}
+
+std::vector<std::string> SpecificationsManifest::FormatEntry(ManifestEntry const & entry) const
+{
+  return {entry.url, entry.revision, entry.hash};
+}
+
+}  // namespace componentUtils
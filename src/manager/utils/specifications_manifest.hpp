@@ -0,0 +1,42 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "persistent_store.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief State of downloaded source at the moment of download.
+ */
+struct ManifestEntry
+{
+  std::string url;
+  std::string revision;
+  std::string hash;
+};
+
+/**
+ * @brief Persisted map from system identifier of downloaded node
+ * to state of its source. All methods are thread safe.
+ */
+class SpecificationsManifest : public PersistentStore<ManifestEntry>
+{
+public:
+  explicit SpecificationsManifest(std::string manifestPath);
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, ManifestEntry & entry) const override;
+
+  std::vector<std::string> FormatEntry(ManifestEntry const & entry) const override;
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,482 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "tar_extractor.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+#include <sc-memory/sc_debug.hpp>
+
+namespace componentUtils
+{
+
+namespace
+{
+// Offsets and sizes of ustar header fields
+size_t constexpr kNameOffset = 0;
+size_t constexpr kNameSize = 100;
+size_t constexpr kModeOffset = 100;
+size_t constexpr kModeSize = 8;
+size_t constexpr kSizeOffset = 124;
+size_t constexpr kSizeSize = 12;
+size_t constexpr kChecksumOffset = 148;
+size_t constexpr kChecksumSize = 8;
+size_t constexpr kTypeOffset = 156;
+size_t constexpr kLinkNameOffset = 157;
+size_t constexpr kLinkNameSize = 100;
+size_t constexpr kMagicOffset = 257;
+size_t constexpr kPrefixOffset = 345;
+size_t constexpr kPrefixSize = 155;
+
+std::string GetField(std::string const & header, size_t offset, size_t size)
+{
+  std::string const field = header.substr(offset, size);
+  return field.substr(0, field.find('\0'));
+}
+
+uint64_t GetNumber(std::string const & header, size_t offset, size_t size)
+{
+  // Big numbers are stored as base-256 with the highest bit set
+  if (static_cast<unsigned char>(header[offset]) & 0x80)
+  {
+    uint64_t number = static_cast<unsigned char>(header[offset]) & 0x7f;
+    for (size_t i = offset + 1; i < offset + size; ++i)
+      number = (number << 8) | static_cast<unsigned char>(header[i]);
+    return number;
+  }
+
+  uint64_t number = 0;
+  for (size_t i = offset; i < offset + size; ++i)
+  {
+    if (header[i] >= '0' && header[i] <= '7')
+      number = number * 8 + (header[i] - '0');
+    else if (header[i] != ' ' || number != 0)
+      break;
+  }
+  return number;
+}
+
+bool IsChecksumValid(std::string const & header)
+{
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < header.size(); ++i)
+  {
+    bool const isChecksumField = i >= kChecksumOffset && i < kChecksumOffset + kChecksumSize;
+    checksum += isChecksumField ? ' ' : static_cast<unsigned char>(header[i]);
+  }
+  return checksum == GetNumber(header, kChecksumOffset, kChecksumSize);
+}
+
+bool WriteAll(int fd, char const * data, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t const writtenSize = write(fd, data, size);
+    if (writtenSize < 0)
+      return false;
+    data += writtenSize;
+    size -= writtenSize;
+  }
+  return true;
+}
+}  // namespace
+
+/**
+ * @param targetPath directory where files are extracted
+ * @param includedPath path in archive that is extracted, the whole archive is extracted if it is empty
+ * @param strippedComponentsCount count of leading directories that are removed from archive paths,
+ * archives of hosting services have one root directory
+ * @param isCompressed false if archive isn't compressed
+ */
+TarExtractor::TarExtractor(
+    std::string targetPath,
+    std::string includedPath,
+    size_t strippedComponentsCount,
+    bool isCompressed)
+  : m_targetPath(std::move(targetPath))
+  , m_includedPath(std::move(includedPath))
+  , m_strippedComponentsCount(strippedComponentsCount)
+  , m_isCompressed(isCompressed)
+  , m_digest(m_includedPath)
+{
+  while (!m_includedPath.empty() && m_includedPath.back() == '/')
+    m_includedPath.pop_back();
+
+  if (!m_isCompressed)
+  {
+    m_isStreamInitialized = true;
+    m_isStreamEnded = true;
+    return;
+  }
+
+  // Window bits with added 32 detect gzip and zlib headers
+  m_isStreamInitialized = inflateInit2(&m_stream, 15 + 32) == Z_OK;
+}
+
+TarExtractor::~TarExtractor()
+{
+  if (m_fd >= 0)
+    close(m_fd);
+  if (m_isCompressed && m_isStreamInitialized)
+    inflateEnd(&m_stream);
+}
+
+/**
+ * @brief Decompress next part of archive and extract its files
+ * @param data archive data
+ * @param size size of data
+ * @return false if archive is invalid or file can't be written
+ */
+bool TarExtractor::Write(char const * data, size_t size)
+{
+  if (!m_isStreamInitialized || m_isFailed)
+    return false;
+
+  if (!m_isCompressed)
+  {
+    m_isFailed = !ProcessTar(data, size);
+    return !m_isFailed;
+  }
+
+  size_t constexpr kOutputSize = 64 * 1024;
+  std::vector<char> output(kOutputSize);
+
+  m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+  m_stream.avail_in = static_cast<uInt>(size);
+  while (m_stream.avail_in > 0 && !m_isStreamEnded)
+  {
+    m_stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    m_stream.avail_out = static_cast<uInt>(output.size());
+
+    int const code = inflate(&m_stream, Z_NO_FLUSH);
+    if (code != Z_OK && code != Z_STREAM_END)
+    {
+      SC_LOG_ERROR("TarExtractor: Archive can't be decompressed");
+      m_isFailed = true;
+      return false;
+    }
+    m_isStreamEnded = code == Z_STREAM_END;
+
+    if (!ProcessTar(output.data(), output.size() - m_stream.avail_out))
+    {
+      m_isFailed = true;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Check that the whole archive is received
+ * @return true if archive is extracted without errors
+ */
+bool TarExtractor::Finish()
+{
+  if (m_fd >= 0)
+  {
+    close(m_fd);
+    m_fd = -1;
+  }
+
+  bool const isComplete = m_state == State::End || (m_state == State::Header && m_header.empty());
+  if (!m_isFailed && (!m_isStreamEnded || !isComplete))
+    SC_LOG_ERROR("TarExtractor: Archive is incomplete");
+
+  return !m_isFailed && m_isStreamEnded && isComplete;
+}
+
+bool TarExtractor::ProcessTar(char const * data, size_t size)
+{
+  while (size > 0)
+  {
+    size_t processedSize = 0;
+    switch (m_state)
+    {
+    case State::Header:
+      processedSize = std::min(size, kBlockSize - m_header.size());
+      m_header.append(data, processedSize);
+      if (m_header.size() == kBlockSize)
+      {
+        if (!ProcessHeader())
+          return false;
+        m_header.clear();
+      }
+      break;
+
+    case State::Data:
+      processedSize = std::min(size, m_entryRemainingSize);
+      if (!ProcessEntryData(data, processedSize))
+        return false;
+      m_entryRemainingSize -= processedSize;
+      if (m_entryRemainingSize == 0 && !FinishEntry())
+        return false;
+      break;
+
+    case State::Padding:
+      processedSize = std::min(size, m_paddingRemainingSize);
+      m_paddingRemainingSize -= processedSize;
+      if (m_paddingRemainingSize == 0)
+        m_state = State::Header;
+      break;
+
+    case State::End:
+      return true;
+    }
+
+    data += processedSize;
+    size -= processedSize;
+  }
+
+  return true;
+}
+
+bool TarExtractor::ProcessHeader()
+{
+  if (std::all_of(m_header.cbegin(), m_header.cend(), [](char symbol) {
+        return symbol == '\0';
+      }))
+  {
+    m_state = State::End;
+    return true;
+  }
+
+  if (!IsChecksumValid(m_header))
+  {
+    SC_LOG_ERROR("TarExtractor: Archive header is invalid");
+    return false;
+  }
+
+  char const type = m_header[kTypeOffset];
+  std::string path = m_nextPath;
+  if (path.empty())
+  {
+    path = GetField(m_header, kNameOffset, kNameSize);
+    std::string const prefix = GetField(m_header, kPrefixOffset, kPrefixSize);
+    if (m_header.compare(kMagicOffset, 5, "ustar") == 0 && !prefix.empty())
+      path = prefix + "/" + path;
+  }
+  std::string linkPath = m_nextLinkPath.empty() ? GetField(m_header, kLinkNameOffset, kLinkNameSize) : m_nextLinkPath;
+  if (type != 'x' && type != 'L' && type != 'K')
+  {
+    m_nextPath.clear();
+    m_nextLinkPath.clear();
+  }
+
+  uint64_t const size = GetNumber(m_header, kSizeOffset, kSizeSize);
+  m_entryRemainingSize = size;
+  m_paddingRemainingSize = (kBlockSize - size % kBlockSize) % kBlockSize;
+  m_entryType = EntryType::Skipped;
+  m_extensionData.clear();
+
+  switch (type)
+  {
+  case 'x':
+    m_entryType = EntryType::Extension;
+    break;
+
+  case 'L':
+    m_entryType = EntryType::LongPath;
+    break;
+
+  case '0':
+  case '7':
+  case '\0':
+  {
+    std::string const targetPath = GetTargetPath(path);
+    if (targetPath.empty())
+      break;
+
+    std::string const directoryPath = targetPath.substr(0, targetPath.rfind('/'));
+    if (!sc_fs_mkdirs(directoryPath.c_str()))
+    {
+      SC_LOG_ERROR("TarExtractor: Can't create \"" + directoryPath + "\"");
+      return false;
+    }
+
+    // File is replaced instead of rewriting, because it can be hardlink to cache
+    unlink(targetPath.c_str());
+    mode_t const mode = static_cast<mode_t>(GetNumber(m_header, kModeOffset, kModeSize) & 0777);
+    m_fd = open(targetPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode | S_IRUSR | S_IWUSR);
+    if (m_fd < 0)
+    {
+      SC_LOG_ERROR("TarExtractor: Can't create \"" + targetPath + "\"");
+      return false;
+    }
+    m_entryType = EntryType::File;
+    m_entryPath = targetPath.substr(m_targetPath.size() + 1);
+    m_entryHasher = std::make_unique<Hasher>();
+    ++m_filesCount;
+    break;
+  }
+
+  case '5':
+  {
+    std::string const targetPath = GetTargetPath(path);
+    if (!targetPath.empty())
+      sc_fs_mkdirs(targetPath.c_str());
+    break;
+  }
+
+  case '2':
+  {
+    std::string const targetPath = GetTargetPath(path);
+    // Links outside of extracted directory aren't created
+    if (targetPath.empty() || linkPath.empty() || linkPath[0] == '/' ||
+        ("/" + linkPath + "/").find("/../") != std::string::npos)
+      break;
+
+    std::string const directoryPath = targetPath.substr(0, targetPath.rfind('/'));
+    sc_fs_mkdirs(directoryPath.c_str());
+    unlink(targetPath.c_str());
+    if (symlink(linkPath.c_str(), targetPath.c_str()) != 0)
+      SC_LOG_WARNING("TarExtractor: Can't create link \"" + targetPath + "\"");
+    break;
+  }
+
+  default:
+    break;
+  }
+
+  if (m_entryRemainingSize > 0)
+    m_state = State::Data;
+  else
+    return FinishEntry();
+
+  return true;
+}
+
+bool TarExtractor::ProcessEntryData(char const * data, size_t size)
+{
+  switch (m_entryType)
+  {
+  case EntryType::File:
+    m_bytesCount += size;
+    m_entryHasher->Update(data, size);
+    if (!WriteAll(m_fd, data, size))
+    {
+      SC_LOG_ERROR("TarExtractor: Can't write extracted file");
+      return false;
+    }
+    break;
+
+  case EntryType::Extension:
+  case EntryType::LongPath:
+    m_extensionData.append(data, size);
+    break;
+
+  case EntryType::Skipped:
+    break;
+  }
+
+  return true;
+}
+
+bool TarExtractor::FinishEntry()
+{
+  if (m_entryType == EntryType::File)
+  {
+    bool const isClosed = close(m_fd) == 0;
+    m_fd = -1;
+    if (!isClosed)
+      return false;
+    m_digest.AddFile(m_entryPath, m_entryHasher->GetHash());
+    m_entryHasher.reset();
+  }
+  else if (m_entryType == EntryType::Extension)
+    ParseExtension();
+  else if (m_entryType == EntryType::LongPath)
+    m_nextPath = m_extensionData.substr(0, m_extensionData.find('\0'));
+
+  m_state = m_paddingRemainingSize > 0 ? State::Padding : State::Header;
+  return true;
+}
+
+/**
+ * @brief Parse pax extended header, it contains records "<length> <key>=<value>\n".
+ * Only paths of the next entry are used.
+ */
+void TarExtractor::ParseExtension()
+{
+  size_t recordBegin = 0;
+  while (recordBegin < m_extensionData.size())
+  {
+    size_t const lengthEnd = m_extensionData.find(' ', recordBegin);
+    if (lengthEnd == std::string::npos)
+      return;
+
+    size_t const recordSize = std::strtoul(m_extensionData.c_str() + recordBegin, nullptr, 10);
+    if (recordSize == 0 || recordBegin + recordSize > m_extensionData.size())
+      return;
+
+    std::string const record = m_extensionData.substr(lengthEnd + 1, recordBegin + recordSize - lengthEnd - 2);
+    size_t const keyEnd = record.find('=');
+    if (keyEnd != std::string::npos)
+    {
+      std::string const key = record.substr(0, keyEnd);
+      if (key == "path")
+        m_nextPath = record.substr(keyEnd + 1);
+      else if (key == "linkpath")
+        m_nextLinkPath = record.substr(keyEnd + 1);
+    }
+
+    recordBegin += recordSize;
+  }
+}
+
+/**
+ * @brief Get path where archive entry is extracted
+ * @param entryPath path of entry in archive
+ * @return Target path, return empty string if entry isn't extracted
+ */
+std::string TarExtractor::GetTargetPath(std::string const & entryPath) const
+{
+  std::vector<std::string> components;
+  size_t componentBegin = 0;
+  while (componentBegin <= entryPath.size())
+  {
+    size_t componentEnd = entryPath.find('/', componentBegin);
+    if (componentEnd == std::string::npos)
+      componentEnd = entryPath.size();
+
+    std::string const component = entryPath.substr(componentBegin, componentEnd - componentBegin);
+    if (component == "..")
+    {
+      SC_LOG_WARNING("TarExtractor: Entry \"" + entryPath + "\" is outside of archive, it is skipped");
+      return "";
+    }
+    if (!component.empty() && component != ".")
+      components.push_back(component);
+
+    componentBegin = componentEnd + 1;
+  }
+
+  if (components.size() <= m_strippedComponentsCount)
+    return "";
+
+  std::string relativePath;
+  for (size_t i = m_strippedComponentsCount; i < components.size(); ++i)
+    relativePath += (relativePath.empty() ? "" : "/") + components[i];
+
+  if (!m_includedPath.empty() && relativePath != m_includedPath &&
+      relativePath.compare(0, m_includedPath.size() + 1, m_includedPath + "/") != 0)
+    return "";
+
+  return m_targetPath + "/" + relativePath;
+}
+
+}  // namespace componentUtils
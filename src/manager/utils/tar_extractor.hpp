@@ -0,0 +1,117 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <zlib.h>
+
+#include "content_digest.hpp"
+#include "hasher.hpp"
+
+namespace componentUtils
+{
+
+/**
+ * @brief Extracts gzip compressed or plain tar archive while it is being received.
+ * Data is decompressed and parsed in memory, and only files under
+ * included path are written into target directory. Extracted files
+ * are hashed while they are written.
+ */
+class TarExtractor
+{
+public:
+  TarExtractor(
+      std::string targetPath,
+      std::string includedPath,
+      size_t strippedComponentsCount = 1,
+      bool isCompressed = true);
+
+  ~TarExtractor();
+
+  bool Write(char const * data, size_t size);
+
+  bool Finish();
+
+  size_t GetFilesCount() const
+  {
+    return m_filesCount;
+  }
+
+  size_t GetBytesCount() const
+  {
+    return m_bytesCount;
+  }
+
+  /**
+   * @brief Get checksum of extracted files, see ContentDigest
+   */
+  std::string GetContentHash() const
+  {
+    return m_digest.GetHash();
+  }
+
+protected:
+  static size_t constexpr kBlockSize = 512;
+
+  enum class State
+  {
+    Header,
+    Data,
+    Padding,
+    End
+  };
+
+  enum class EntryType
+  {
+    Skipped,
+    File,
+    Extension,
+    LongPath
+  };
+
+  std::string m_targetPath;
+  std::string m_includedPath;
+  size_t m_strippedComponentsCount;
+  bool m_isCompressed;
+
+  z_stream m_stream = {};
+  bool m_isStreamInitialized = false;
+  bool m_isStreamEnded = false;
+  bool m_isFailed = false;
+
+  State m_state = State::Header;
+  std::string m_header;
+  EntryType m_entryType = EntryType::Skipped;
+  size_t m_entryRemainingSize = 0;
+  size_t m_paddingRemainingSize = 0;
+  int m_fd = -1;
+  std::string m_entryPath;
+  std::unique_ptr<Hasher> m_entryHasher;
+  std::string m_extensionData;
+  std::string m_nextPath;
+  std::string m_nextLinkPath;
+
+  size_t m_filesCount = 0;
+  size_t m_bytesCount = 0;
+  ContentDigest m_digest;
+
+  bool ProcessTar(char const * data, size_t size);
+
+  bool ProcessHeader();
+
+  bool ProcessEntryData(char const * data, size_t size);
+
+  bool FinishEntry();
+
+  void ParseExtension();
+
+  std::string GetTargetPath(std::string const & entryPath) const;
+};
+
+}  // namespace componentUtils
@@ -0,0 +1,100 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "thread_pool.hpp"
+
+#include <sc-memory/sc_debug.hpp>
+
+namespace componentUtils
+{
+
+ThreadPool::ThreadPool(size_t threadsCount)
+{
+  if (threadsCount == 0)
+    threadsCount = 1;
+
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(&ThreadPool::Work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopped = true;
+  }
+  m_taskAdded.notify_all();
+
+  for (std::thread & worker : m_workers)
+    worker.join();
+}
+
+/**
+ * @brief Add task to the queue. It will be executed
+ * by the first free worker.
+ * @param task function to execute
+ */
+void ThreadPool::Submit(std::function<void()> const & task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push(task);
+  }
+  m_taskAdded.notify_one();
+}
+
+/**
+ * @brief Block until all submitted tasks are executed.
+ */
+void ThreadPool::Wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_tasksFinished.wait(lock, [this]() {
+    return m_tasks.empty() && m_activeTasksCount == 0;
+  });
+}
+
+void ThreadPool::Work()
+{
+  while (true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskAdded.wait(lock, [this]() {
+        return m_isStopped || !m_tasks.empty();
+      });
+
+      if (m_tasks.empty())
+        return;
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop();
+      ++m_activeTasksCount;
+    }
+
+    try
+    {
+      task();
+    }
+    catch (utils::ScException const & exception)
+    {
+      SC_LOG_ERROR(exception.Message());
+    }
+    catch (std::exception const & exception)
+    {
+      SC_LOG_ERROR(exception.what());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_activeTasksCount;
+    }
+    m_tasksFinished.notify_all();
+  }
+}
+
+}  // namespace componentUtils
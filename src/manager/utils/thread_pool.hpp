@@ -0,0 +1,56 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace componentUtils
+{
+
+/**
+ * @brief Fixed size pool of workers. Tasks mustn't use sc-memory context
+ * that is owned by another thread.
+ */
+class ThreadPool
+{
+public:
+  explicit ThreadPool(size_t threadsCount);
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool & operator=(ThreadPool const &) = delete;
+
+  ~ThreadPool();
+
+  void Submit(std::function<void()> const & task);
+
+  void Wait();
+
+  size_t GetThreadsCount() const
+  {
+    return m_workers.size();
+  }
+
+protected:
+  void Work();
+
+  std::vector<std::thread> m_workers;
+  std::queue<std::function<void()>> m_tasks;
+
+  std::mutex m_mutex;
+  std::condition_variable m_taskAdded;
+  std::condition_variable m_tasksFinished;
+
+  size_t m_activeTasksCount = 0;
+  bool m_isStopped = false;
+};
+
+}  // namespace componentUtils
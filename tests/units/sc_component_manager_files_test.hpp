@@ -0,0 +1,64 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "src/manager/utils/file_utils.hpp"
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+/**
+ * @brief Fixture of tests that work with files. Each test gets its own temporary
+ * directory, it is removed with all its files after test.
+ */
+class ScComponentManagerFilesTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_rootPath = componentUtils::FileUtils::MakeTemporaryDirectory("/tmp");
+    ASSERT_FALSE(m_rootPath.empty());
+  }
+
+  void TearDown() override
+  {
+    if (!m_rootPath.empty())
+      componentUtils::FileUtils::RemoveDirectory(m_rootPath);
+  }
+
+  static std::string ReadFile(std::string const & path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  }
+
+  /**
+   * @brief Write file, its parent directories are created if they don't exist
+   * @param path path of file
+   * @param content content of file, previous content is replaced
+   */
+  static void WriteFile(std::string const & path, std::string const & content)
+  {
+    size_t const parentEnd = path.rfind('/');
+    if (parentEnd != std::string::npos && parentEnd != 0)
+      sc_fs_mkdirs(path.substr(0, parentEnd).c_str());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+  }
+
+protected:
+  std::string m_rootPath;
+};
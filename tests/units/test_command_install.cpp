@@ -0,0 +1,309 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_component_manager_files_test.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "src/manager/commands/command_install/sc_component_manager_command_install.hpp"
+#include "src/manager/utils/sc_component_utils.hpp"
+
+namespace
+{
+/**
+ * @brief Install command with stubbed download. Downloaded component contains only its readme,
+ * and components that are marked as failed aren't downloaded. Stub can be disabled, then downloads
+ * are only recorded.
+ */
+class TestCommandInstall : public ScComponentManagerCommandInstall
+{
+public:
+  using ScComponentManagerCommandInstall::ScComponentManagerCommandInstall;
+  using ScComponentManagerCommandInstall::InstallComponents;
+  using ScComponentManagerCommandInstall::ResolveDependencies;
+
+  void FailDownload(std::string const & componentIdtf)
+  {
+    m_failedComponents.insert(componentIdtf);
+  }
+
+  void DisableDownloadStub()
+  {
+    m_isDownloadStubbed = false;
+  }
+
+  std::vector<std::string> GetDownloadedComponents() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_downloadedComponents;
+  }
+
+protected:
+  void DownloadComponent(ComponentInstallation & installation) override
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_downloadedComponents.push_back(installation.systemIdtf);
+    }
+
+    if (!m_isDownloadStubbed)
+    {
+      ScComponentManagerCommandInstall::DownloadComponent(installation);
+      return;
+    }
+
+    if (m_failedComponents.count(installation.systemIdtf))
+    {
+      installation.failures.push_back("Component \"" + installation.systemIdtf + "\": download failed");
+      return;
+    }
+
+    std::string const componentPath = m_specificationsPath + "/" + installation.systemIdtf;
+    sc_fs_mkdirs(componentPath.c_str());
+    std::ofstream(componentPath + "/README.md") << installation.systemIdtf;
+    installation.url = installation.requests.front().url;
+    installation.isDownloaded = true;
+  }
+
+  bool m_isDownloadStubbed = true;
+  std::unordered_set<std::string> m_failedComponents;
+  mutable std::mutex m_mutex;
+  std::vector<std::string> m_downloadedComponents;
+};
+
+size_t GetPosition(std::vector<std::string> const & components, std::string const & component)
+{
+  return std::find(components.cbegin(), components.cend(), component) - components.cbegin();
+}
+}  // namespace
+
+class ScComponentManagerInstallTest : public ScComponentManagerFilesTest
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(ScComponentManagerFilesTest::SetUp());
+
+    std::string const repoPath = m_rootPath + "/repo";
+    sc_memory_params params;
+    sc_memory_params_clear(&params);
+    params.clear = SC_TRUE;
+    params.repo_path = repoPath.c_str();
+    ASSERT_TRUE(ScMemory::Initialize(params));
+    m_context = std::make_unique<ScMemoryContext>("sc-component-manager-install-test");
+    keynodes::ScComponentManagerKeynodes::InitGlobal();
+
+    m_specificationsPath = m_rootPath + "/specifications";
+    sc_fs_mkdirs(m_specificationsPath.c_str());
+    ScComponentManagerSettings settings;
+    settings.installThreadsCount = 2;
+    m_commandInstall = CreateCommandInstall(settings);
+  }
+
+  void TearDown() override
+  {
+    m_commandInstall.reset();
+    if (m_context)
+    {
+      m_context->Destroy();
+      m_context.reset();
+      ScMemory::Shutdown(false);
+    }
+
+    ScComponentManagerFilesTest::TearDown();
+  }
+
+  std::unique_ptr<TestCommandInstall> CreateCommandInstall(ScComponentManagerSettings const & settings) const
+  {
+    return std::make_unique<TestCommandInstall>(
+        m_specificationsPath,
+        std::make_shared<DownloaderHandler>(m_specificationsPath, settings),
+        std::make_shared<componentUtils::ProcessRunner>(),
+        settings);
+  }
+
+  /**
+   * @brief Add specification of reusable component with GitHub address to sc-memory
+   * @param componentIdtf system identifier of component
+   * @param dependencies system identifiers of its dependencies
+   * @return true if specification is loaded
+   */
+  bool AddComponent(std::string const & componentIdtf, std::vector<std::string> const & dependencies = {})
+  {
+    std::string scsText = "concept_reusable_component -> " + componentIdtf + ";;\n" + componentIdtf +
+                          "\n  => nrel_component_address: [https://github.com/ostis-ai/" + componentIdtf +
+                          "] (* <- concept_github_url;; *)\n  => nrel_installation_method: ..." +
+                          " (* <- concept_component_dynamically_installed_method;; *)";
+    if (!dependencies.empty())
+    {
+      scsText += ";\n  => nrel_component_dependencies: ... (*";
+      for (std::string const & dependency : dependencies)
+        scsText += " -> " + dependency + ";;";
+      scsText += " *)";
+    }
+
+    return componentUtils::LoadUtils::LoadScsText(m_context.get(), scsText + ";;");
+  }
+
+  std::unique_ptr<ScMemoryContext> m_context;
+  std::string m_specificationsPath;
+  std::unique_ptr<TestCommandInstall> m_commandInstall;
+};
+
+TEST_F(ScComponentManagerInstallTest, ResolveDependencies)
+{
+  ASSERT_TRUE(AddComponent("common_component"));
+  ASSERT_TRUE(AddComponent("kb_component", {"common_component", "missing_component"}));
+  ASSERT_TRUE(AddComponent("app_component", {"kb_component", "common_component"}));
+
+  componentUtils::DependencyGraph graph;
+  std::unordered_set<std::string> invalidComponents;
+  ExecutionResult executionResult;
+  EXPECT_TRUE(m_commandInstall->ResolveDependencies(
+      m_context.get(),
+      {m_context->HelperFindBySystemIdtf("app_component")},
+      graph,
+      invalidComponents,
+      executionResult));
+
+  EXPECT_TRUE(graph.Contains("app_component"));
+  EXPECT_TRUE(graph.Contains("kb_component"));
+  EXPECT_TRUE(graph.Contains("common_component"));
+  EXPECT_FALSE(graph.Contains("missing_component"));
+  EXPECT_EQ(invalidComponents, std::unordered_set<std::string>({"missing_component"}));
+  EXPECT_EQ(executionResult, ExecutionResult({"Dependency \"missing_component\" can't be installed"}));
+
+  std::vector<std::string> dependencies = graph.GetDependencies("app_component");
+  std::sort(dependencies.begin(), dependencies.end());
+  EXPECT_EQ(dependencies, std::vector<std::string>({"common_component", "kb_component"}));
+  EXPECT_TRUE(graph.GetDependencies("common_component").empty());
+}
+
+TEST_F(ScComponentManagerInstallTest, InstallInDependenciesOrder)
+{
+  ASSERT_TRUE(AddComponent("common_component"));
+  ASSERT_TRUE(AddComponent("kb_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("ui_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("app_component", {"kb_component", "ui_component"}));
+
+  ExecutionResult const executionResult = m_commandInstall->Execute(m_context.get(), {{"idtf", {"app_component"}}});
+  EXPECT_TRUE(executionResult.empty());
+
+  // Shared dependency is installed once, and each component is installed after its dependencies
+  std::vector<std::string> const downloaded = m_commandInstall->GetDownloadedComponents();
+  ASSERT_EQ(downloaded.size(), 4u);
+  EXPECT_LT(GetPosition(downloaded, "common_component"), GetPosition(downloaded, "kb_component"));
+  EXPECT_LT(GetPosition(downloaded, "common_component"), GetPosition(downloaded, "ui_component"));
+  EXPECT_LT(GetPosition(downloaded, "kb_component"), GetPosition(downloaded, "app_component"));
+  EXPECT_LT(GetPosition(downloaded, "ui_component"), GetPosition(downloaded, "app_component"));
+  EXPECT_EQ(ReadFile(m_specificationsPath + "/app_component/README.md"), "app_component");
+}
+
+TEST_F(ScComponentManagerInstallTest, PropagateFailure)
+{
+  ASSERT_TRUE(AddComponent("common_component"));
+  ASSERT_TRUE(AddComponent("kb_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("ui_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("app_component", {"kb_component", "ui_component"}));
+  m_commandInstall->FailDownload("kb_component");
+
+  componentUtils::DependencyGraph graph;
+  std::unordered_set<std::string> failedComponents;
+  ExecutionResult executionResult;
+  ASSERT_TRUE(m_commandInstall->ResolveDependencies(
+      m_context.get(),
+      {m_context->HelperFindBySystemIdtf("app_component")},
+      graph,
+      failedComponents,
+      executionResult));
+
+  std::vector<std::string> installOrder;
+  std::vector<std::string> cycle;
+  ASSERT_TRUE(graph.GetInstallOrder({"app_component"}, installOrder, cycle));
+  m_commandInstall->InstallComponents(m_context.get(), graph, installOrder, failedComponents, executionResult);
+
+  // Failed component fails its dependents without starting them, other components are installed
+  std::vector<std::string> downloaded = m_commandInstall->GetDownloadedComponents();
+  std::sort(downloaded.begin(), downloaded.end());
+  EXPECT_EQ(downloaded, std::vector<std::string>({"common_component", "kb_component", "ui_component"}));
+  EXPECT_EQ(failedComponents, std::unordered_set<std::string>({"kb_component", "app_component"}));
+  EXPECT_EQ(
+      executionResult,
+      ExecutionResult(
+          {"Component \"kb_component\": download failed",
+           "Component \"app_component\": dependency \"kb_component\" is not installed"}));
+  EXPECT_TRUE(componentUtils::FileUtils::IsDirectory(m_specificationsPath + "/ui_component"));
+}
+
+TEST_F(ScComponentManagerInstallTest, PlanInstallation)
+{
+  ASSERT_TRUE(AddComponent("common_component"));
+  ASSERT_TRUE(AddComponent("kb_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("app_component", {"kb_component"}));
+
+  ExecutionResult const plan =
+      m_commandInstall->Execute(m_context.get(), {{"idtf", {"app_component"}}, {"plan", {}}});
+
+  // Plan doesn't download anything, and components are planned in dependencies order
+  EXPECT_TRUE(m_commandInstall->GetDownloadedComponents().empty());
+  ASSERT_EQ(plan.size(), 5u);
+  EXPECT_EQ(
+      plan[0], "Plan: \"common_component\": fetch https://github.com/ostis-ai/common_component, no previous install");
+  EXPECT_EQ(plan[1], "Plan: \"kb_component\": fetch https://github.com/ostis-ai/kb_component, no previous install");
+  EXPECT_EQ(plan[2], "Plan: \"app_component\": fetch https://github.com/ostis-ai/app_component, no previous install");
+  EXPECT_EQ(plan[3], "Plan: 3 components to install, 0 skipped, 3 without previous install");
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(m_specificationsPath + "/app_component"));
+}
+
+TEST_F(ScComponentManagerInstallTest, InstallAllMarkedComponents)
+{
+  ASSERT_TRUE(AddComponent("common_component"));
+  ASSERT_TRUE(AddComponent("kb_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("ui_component", {"common_component"}));
+  ASSERT_TRUE(AddComponent("unmarked_component"));
+  ASSERT_TRUE(componentUtils::LoadUtils::LoadScsText(
+      m_context.get(), "concept_need_to_install -> kb_component; ui_component;;"));
+
+  ExecutionResult const executionResult = m_commandInstall->Execute(m_context.get(), {});
+  EXPECT_TRUE(executionResult.empty());
+
+  // Marked components are installed as one graph, so their shared dependency is installed once
+  std::vector<std::string> downloaded = m_commandInstall->GetDownloadedComponents();
+  ASSERT_EQ(downloaded.size(), 3u);
+  EXPECT_EQ(downloaded.front(), "common_component");
+  std::sort(downloaded.begin(), downloaded.end());
+  EXPECT_EQ(downloaded, std::vector<std::string>({"common_component", "kb_component", "ui_component"}));
+}
+
+TEST_F(ScComponentManagerInstallTest, SkipUpToDateMirroredComponent)
+{
+  ASSERT_TRUE(AddComponent("mirrored_component"));
+  WriteFile(m_rootPath + "/mirror/ostis-ai/mirrored_component/README.md", "mirrored");
+  ScComponentManagerSettings settings;
+  settings.mirrorRoot = m_rootPath + "/mirror";
+  settings.mirrorPrefixes = {"https://github.com/"};
+  CommandParameters const parameters = {{"idtf", {"mirrored_component"}}};
+
+  std::unique_ptr<TestCommandInstall> commandInstall = CreateCommandInstall(settings);
+  commandInstall->DisableDownloadStub();
+  EXPECT_TRUE(commandInstall->Execute(m_context.get(), parameters).empty());
+  EXPECT_EQ(commandInstall->GetDownloadedComponents().size(), 1u);
+  EXPECT_EQ(ReadFile(m_specificationsPath + "/mirrored_component/README.md"), "mirrored");
+
+  // Mirror has no revision, so installed component is compared with content of mirror
+  commandInstall = CreateCommandInstall(settings);
+  commandInstall->DisableDownloadStub();
+  EXPECT_TRUE(commandInstall->Execute(m_context.get(), parameters).empty());
+  EXPECT_TRUE(commandInstall->GetDownloadedComponents().empty());
+
+  WriteFile(m_rootPath + "/mirror/ostis-ai/mirrored_component/README.md", "changed");
+  commandInstall = CreateCommandInstall(settings);
+  commandInstall->DisableDownloadStub();
+  EXPECT_TRUE(commandInstall->Execute(m_context.get(), parameters).empty());
+  EXPECT_EQ(commandInstall->GetDownloadedComponents().size(), 1u);
+  EXPECT_EQ(ReadFile(m_specificationsPath + "/mirrored_component/README.md"), "changed");
+}
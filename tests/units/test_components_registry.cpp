@@ -0,0 +1,49 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/components_registry.hpp"
+
+using ScComponentManagerComponentsRegistryTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerComponentsRegistryTest, SaveLoad)
+{
+  std::string const registryPath = m_rootPath + "/.components_registry";
+
+  componentUtils::ComponentsRegistry registry(registryPath);
+  componentUtils::RegistryEntry catEntry;
+  catEntry.url = "https://github.com/MksmOrlov/cat-kb-component";
+  catEntry.revision = "0123456789abcdef";
+  catEntry.installTime = 1700000000;
+  catEntry.hash = "cafe";
+  catEntry.specificationHash = "beef";
+  catEntry.files = {"kb/cat.scs", "specification.scs"};
+  registry.Update("cat", catEntry);
+  registry.Update("dog", {});
+  registry.Update("removed", {});
+  registry.Remove("removed");
+  registry.Save();
+  std::ofstream(registryPath, std::ios::app) << "broken\tline\nfile\torphan.scs\n";
+
+  componentUtils::ComponentsRegistry loadedRegistry(registryPath);
+  loadedRegistry.Load();
+  componentUtils::RegistryEntry entry;
+  ASSERT_TRUE(loadedRegistry.Find("cat", entry));
+  EXPECT_EQ(entry.url, catEntry.url);
+  EXPECT_EQ(entry.revision, catEntry.revision);
+  EXPECT_EQ(entry.installTime, catEntry.installTime);
+  EXPECT_EQ(entry.hash, catEntry.hash);
+  EXPECT_EQ(entry.specificationHash, catEntry.specificationHash);
+  EXPECT_EQ(entry.files, catEntry.files);
+
+  ASSERT_TRUE(loadedRegistry.Find("dog", entry));
+  EXPECT_TRUE(entry.files.empty());
+  EXPECT_FALSE(loadedRegistry.Find("removed", entry));
+}
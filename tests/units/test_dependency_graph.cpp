@@ -0,0 +1,82 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/manager/utils/dependency_graph.hpp"
+
+TEST(ScComponentManagerDependencyGraphTest, SharedDependency)
+{
+  componentUtils::DependencyGraph graph;
+  graph.AddComponent("cat", {"animal", "pet"});
+  graph.AddComponent("dog", {"animal", "pet", "animal"});
+  graph.AddComponent("pet", {"animal"});
+  graph.AddComponent("animal", {});
+
+  std::vector<std::string> order;
+  std::vector<std::string> cycle;
+  ASSERT_TRUE(graph.GetInstallOrder({"cat", "dog", "cat"}, order, cycle));
+  EXPECT_EQ(order, std::vector<std::string>({"animal", "pet", "cat", "dog"}));
+  EXPECT_TRUE(cycle.empty());
+  EXPECT_EQ(graph.GetDependencies("dog").size(), 2u);
+}
+
+TEST(ScComponentManagerDependencyGraphTest, UnknownDependency)
+{
+  componentUtils::DependencyGraph graph;
+  graph.AddComponent("cat", {"animal"});
+
+  std::vector<std::string> order;
+  std::vector<std::string> cycle;
+  ASSERT_TRUE(graph.GetInstallOrder({"cat"}, order, cycle));
+  EXPECT_EQ(order, std::vector<std::string>({"animal", "cat"}));
+  EXPECT_FALSE(graph.Contains("animal"));
+}
+
+TEST(ScComponentManagerDependencyGraphTest, Cycle)
+{
+  componentUtils::DependencyGraph graph;
+  graph.AddComponent("app", {"cat"});
+  graph.AddComponent("cat", {"pet"});
+  graph.AddComponent("pet", {"animal"});
+  graph.AddComponent("animal", {"cat"});
+
+  std::vector<std::string> order;
+  std::vector<std::string> cycle;
+  EXPECT_FALSE(graph.GetInstallOrder({"app"}, order, cycle));
+  EXPECT_EQ(cycle, std::vector<std::string>({"cat", "pet", "animal", "cat"}));
+
+  graph.AddComponent("self", {"self"});
+  EXPECT_FALSE(graph.GetInstallOrder({"self"}, order, cycle));
+  EXPECT_EQ(cycle, std::vector<std::string>({"self", "self"}));
+}
+
+TEST(ScComponentManagerDependencyGraphTest, CriticalPath)
+{
+  componentUtils::DependencyGraph graph;
+  graph.AddComponent("app", {"cat", "dog"});
+  graph.AddComponent("cat", {"animal"});
+  graph.AddComponent("dog", {"animal"});
+  graph.AddComponent("animal", {});
+  graph.AddComponent("tool", {});
+
+  std::vector<std::string> order;
+  std::vector<std::string> cycle;
+  ASSERT_TRUE(graph.GetInstallOrder({"app", "tool"}, order, cycle));
+
+  std::unordered_map<std::string, std::chrono::milliseconds> const durations = {
+      {"app", std::chrono::milliseconds(10)},
+      {"cat", std::chrono::milliseconds(20)},
+      {"dog", std::chrono::milliseconds(50)},
+      {"animal", std::chrono::milliseconds(5)},
+      {"tool", std::chrono::milliseconds(60)}};
+  std::vector<std::string> path;
+  EXPECT_EQ(graph.GetCriticalPath(order, durations, path), std::chrono::milliseconds(65));
+  EXPECT_EQ(path, std::vector<std::string>({"animal", "dog", "app"}));
+
+  EXPECT_EQ(graph.GetCriticalPath(order, {}, path), std::chrono::milliseconds(0));
+  EXPECT_EQ(path.size(), 1u);
+}
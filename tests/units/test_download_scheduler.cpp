@@ -0,0 +1,200 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "src/manager/downloader/download_scheduler.hpp"
+
+namespace
+{
+ScComponentManagerSettings GetSettings(size_t threadsCount, size_t hostConnectionsLimit, size_t retriesCount)
+{
+  ScComponentManagerSettings settings;
+  settings.downloadThreadsCount = threadsCount;
+  settings.hostConnectionsLimit = hostConnectionsLimit;
+  settings.downloadRetriesCount = retriesCount;
+  settings.downloadRetryDelay = std::chrono::milliseconds(1);
+  return settings;
+}
+
+DownloadAttempt GetAttempt(bool isDownloaded)
+{
+  DownloadAttempt attempt;
+  attempt.status = isDownloaded ? DownloadStatus::Downloaded : DownloadStatus::Failed;
+  return attempt;
+}
+
+DownloadRequest GetRequest(std::string const & url)
+{
+  DownloadRequest request;
+  request.url = url;
+  return request;
+}
+}  // namespace
+
+TEST(ScComponentManagerDownloadSchedulerTest, RetryFailedDownload)
+{
+  std::atomic<size_t> attemptsCount{0};
+  DownloadScheduler scheduler(
+      [&attemptsCount](DownloadRequest const &) {
+        DownloadAttempt attempt = GetAttempt(++attemptsCount > 2);
+        attempt.revision = "0123abc";
+        attempt.bytesCount = 10;
+        return attempt;
+      },
+      GetSettings(2, 2, 3));
+
+  DownloadResult const result = scheduler.Submit(GetRequest("https://github.com/ostis-ai/sc-machine")).get();
+  EXPECT_TRUE(result.isSuccess);
+  EXPECT_EQ(result.url, "https://github.com/ostis-ai/sc-machine");
+  EXPECT_EQ(result.revision, "0123abc");
+  EXPECT_EQ(result.attemptsCount, 3u);
+  EXPECT_EQ(result.bytesCount, 10u);
+  EXPECT_EQ(scheduler.GetStatistics().retriesCount, 2u);
+}
+
+TEST(ScComponentManagerDownloadSchedulerTest, GiveUpAfterRetries)
+{
+  DownloadScheduler scheduler(
+      [](DownloadRequest const &) {
+        return GetAttempt(false);
+      },
+      GetSettings(1, 1, 2));
+
+  DownloadResult const result = scheduler.Submit(GetRequest("https://github.com/ostis-ai/sc-machine")).get();
+  EXPECT_FALSE(result.isSuccess);
+  EXPECT_EQ(result.attemptsCount, 3u);
+  EXPECT_EQ(scheduler.GetStatistics().failedRequestsCount, 1u);
+}
+
+TEST(ScComponentManagerDownloadSchedulerTest, DontRetryPermanentFailure)
+{
+  std::atomic<size_t> attemptsCount{0};
+  DownloadScheduler scheduler(
+      [&attemptsCount](DownloadRequest const &) {
+        ++attemptsCount;
+        DownloadAttempt attempt;
+        attempt.status = DownloadStatus::FailedPermanently;
+        return attempt;
+      },
+      GetSettings(1, 1, 3));
+
+  DownloadResult const result = scheduler.Submit(GetRequest("https://github.com/ostis-ai/missing")).get();
+  EXPECT_FALSE(result.isSuccess);
+  EXPECT_EQ(result.attemptsCount, 1u);
+  EXPECT_EQ(attemptsCount, 1u);
+  EXPECT_EQ(scheduler.GetStatistics().retriesCount, 0u);
+}
+
+TEST(ScComponentManagerDownloadSchedulerTest, LimitHostConnections)
+{
+  std::atomic<size_t> activeCount{0};
+  std::atomic<size_t> maxActiveCount{0};
+  DownloadScheduler scheduler(
+      [&activeCount, &maxActiveCount](DownloadRequest const &) {
+        size_t const count = ++activeCount;
+        size_t maxCount = maxActiveCount;
+        while (count > maxCount && !maxActiveCount.compare_exchange_weak(maxCount, count))
+          ;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --activeCount;
+        return GetAttempt(true);
+      },
+      GetSettings(4, 1, 0));
+
+  std::vector<std::shared_future<DownloadResult>> results;
+  for (size_t i = 0; i < 8; ++i)
+    results.push_back(scheduler.Submit(GetRequest("https://github.com/ostis-ai/repository-" + std::to_string(i))));
+
+  for (std::shared_future<DownloadResult> const & result : results)
+    EXPECT_TRUE(result.get().isSuccess);
+  EXPECT_EQ(maxActiveCount, 1u);
+  EXPECT_EQ(scheduler.GetStatistics().requestsCount, 8u);
+}
+
+TEST(ScComponentManagerDownloadSchedulerTest, CollapseSameRequests)
+{
+  std::atomic<size_t> attemptsCount{0};
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  using PlacedPaths = std::vector<std::pair<std::string, std::string>>;
+  PlacedPaths placedPaths;
+  DownloadScheduler scheduler(
+      [&attemptsCount, released](DownloadRequest const &) {
+        ++attemptsCount;
+        released.wait();
+        DownloadAttempt attempt = GetAttempt(true);
+        attempt.bytesCount = 10;
+        return attempt;
+      },
+      GetSettings(2, 2, 0),
+      [&placedPaths](DownloadRequest const & downloadedRequest, DownloadRequest const & request) {
+        placedPaths.emplace_back(downloadedRequest.downloadPath, request.downloadPath);
+        return true;
+      });
+
+  DownloadRequest request = GetRequest("https://github.com/ostis-ai/sc-machine");
+  request.downloadPath = "sc-machine";
+  DownloadRequest otherPathRequest = request;
+  otherPathRequest.downloadPath = "sc-machine-copy";
+  // Request with expected checksum isn't placed from download that isn't verified by it
+  DownloadRequest checksumRequest = otherPathRequest;
+  checksumRequest.checksum = "0123abc";
+
+  std::vector<std::shared_future<DownloadResult>> results;
+  results.push_back(scheduler.Submit(request));
+  results.push_back(scheduler.Submit(request));
+  results.push_back(scheduler.Submit(otherPathRequest));
+  results.push_back(scheduler.Submit(otherPathRequest));
+  results.push_back(scheduler.Submit(request));
+  results.push_back(scheduler.Submit(checksumRequest));
+  release.set_value();
+
+  for (std::shared_future<DownloadResult> const & result : results)
+    EXPECT_TRUE(result.get().isSuccess);
+  EXPECT_EQ(attemptsCount, 2u);
+  EXPECT_EQ(results[0].get().bytesCount, 10u);
+  EXPECT_EQ(results[2].get().bytesCount, 0u);
+  EXPECT_EQ(placedPaths, PlacedPaths({{"sc-machine", "sc-machine-copy"}}));
+  EXPECT_EQ(scheduler.GetStatistics().collapsedRequestsCount, 4u);
+  EXPECT_EQ(scheduler.GetStatistics().bytesCount, 20u);
+
+  // Completed request doesn't hide the next downloads of source
+  EXPECT_TRUE(scheduler.Submit(otherPathRequest).get().isSuccess);
+  EXPECT_EQ(attemptsCount, 3u);
+}
+
+TEST(ScComponentManagerDownloadSchedulerTest, FailWaitersOfFailedDownload)
+{
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  size_t placesCount = 0;
+  DownloadScheduler scheduler(
+      [released](DownloadRequest const &) {
+        released.wait();
+        return GetAttempt(false);
+      },
+      GetSettings(1, 1, 0),
+      [&placesCount](DownloadRequest const &, DownloadRequest const &) {
+        ++placesCount;
+        return true;
+      });
+
+  DownloadRequest request = GetRequest("https://github.com/ostis-ai/sc-machine");
+  request.downloadPath = "sc-machine";
+  DownloadRequest otherPathRequest = request;
+  otherPathRequest.downloadPath = "sc-machine-copy";
+
+  std::shared_future<DownloadResult> const result = scheduler.Submit(request);
+  std::shared_future<DownloadResult> const otherPathResult = scheduler.Submit(otherPathRequest);
+  release.set_value();
+
+  EXPECT_FALSE(result.get().isSuccess);
+  EXPECT_FALSE(otherPathResult.get().isSuccess);
+  EXPECT_EQ(placesCount, 0u);
+}
@@ -0,0 +1,146 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_component_manager_files_test.hpp"
+
+#include "src/manager/downloader/downloader_git.hpp"
+#include "src/manager/utils/process_runner.hpp"
+
+namespace
+{
+class TestDownloaderGit : public DownloaderGit
+{
+public:
+  using DownloaderGit::DownloaderGit;
+
+  bool IsCachePartial(std::string const & urlAddress)
+  {
+    return IsPartialRepository(GetRepositoryPath(urlAddress));
+  }
+};
+}  // namespace
+
+class ScComponentManagerDownloaderGitTest : public ScComponentManagerFilesTest
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(ScComponentManagerFilesTest::SetUp());
+    m_sourcePath = m_rootPath + "/source";
+
+    ASSERT_TRUE(Run({"git", "init", "--quiet", m_sourcePath}));
+    // Local repository serves partial clones only if filters are allowed
+    ASSERT_TRUE(Run({"git", "config", "uploadpack.allowFilter", "true"}, m_sourcePath));
+    WriteFile(m_sourcePath + "/kb/kept.scs", "kept");
+    WriteFile(m_sourcePath + "/kb/changed.scs", "changed");
+    WriteFile(m_sourcePath + "/removed.txt", "removed");
+    WriteFile(m_sourcePath + "/docs/removed/readme.md", "removed");
+    ASSERT_TRUE(Commit());
+  }
+
+  bool Run(std::vector<std::string> const & arguments, std::string const & workingDirectory = "")
+  {
+    componentUtils::ProcessOptions options;
+    options.arguments = arguments;
+    options.workingDirectory = workingDirectory;
+    options.isOutputCaptured = true;
+    return m_runner.Run(options).IsSuccess();
+  }
+
+  bool Commit()
+  {
+    return Run({"git", "add", "--all"}, m_sourcePath) &&
+           Run({"git", "-c", "user.name=test", "-c", "user.email=test@test", "commit", "--quiet", "-m", "commit"},
+               m_sourcePath);
+  }
+
+  componentUtils::ProcessRunner m_runner;
+  std::string m_sourcePath;
+};
+
+TEST_F(ScComponentManagerDownloaderGitTest, DownloadChanges)
+{
+  DownloaderGit downloader(
+      m_rootPath + "/cache", std::make_shared<componentUtils::ProcessRunner>(), std::chrono::milliseconds(60000));
+  std::string const url = "file://" + m_sourcePath;
+  std::string const downloadPath = m_rootPath + "/component";
+
+  ASSERT_EQ(downloader.Download(downloadPath, url), DownloadStatus::Downloaded);
+  std::string const revision = downloader.GetRevision(url);
+  ASSERT_EQ(revision.size(), 40u);
+
+  std::string currentRevision;
+  std::vector<std::string> changedPaths;
+  EXPECT_TRUE(downloader.DownloadChanges(downloadPath, url, revision, currentRevision, changedPaths));
+  EXPECT_EQ(currentRevision, revision);
+  EXPECT_TRUE(changedPaths.empty());
+
+  WriteFile(m_sourcePath + "/kb/changed.scs", "updated");
+  WriteFile(m_sourcePath + "/kb/added.scs", "added");
+  std::remove((m_sourcePath + "/removed.txt").c_str());
+  componentUtils::FileUtils::RemoveDirectory(m_sourcePath + "/docs");
+  ASSERT_TRUE(Commit());
+
+  EXPECT_TRUE(downloader.DownloadChanges(downloadPath, url, revision, currentRevision, changedPaths));
+  EXPECT_EQ(currentRevision, downloader.GetRevision(url));
+  EXPECT_EQ(changedPaths, std::vector<std::string>({"kb/added.scs", "kb/changed.scs"}));
+  EXPECT_EQ(ReadFile(downloadPath + "/kb/changed.scs"), "updated");
+  EXPECT_EQ(ReadFile(downloadPath + "/kb/added.scs"), "added");
+  EXPECT_EQ(ReadFile(downloadPath + "/kb/kept.scs"), "kept");
+  EXPECT_FALSE(sc_fs_isfile((downloadPath + "/removed.txt").c_str()));
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(downloadPath + "/docs"));
+  EXPECT_TRUE(componentUtils::FileUtils::IsDirectory(downloadPath));
+  EXPECT_FALSE(sc_fs_isfile((downloadPath + "/.archive.tar").c_str()));
+
+  EXPECT_FALSE(downloader.DownloadChanges(downloadPath, url, std::string(40, '0'), currentRevision, changedPaths));
+}
+
+TEST_F(ScComponentManagerDownloaderGitTest, FullDownloadFromPartialCache)
+{
+  TestDownloaderGit downloader(
+      m_rootPath + "/cache", std::make_shared<componentUtils::ProcessRunner>(), std::chrono::milliseconds(60000));
+  std::string const url = "file://" + m_sourcePath;
+
+  ASSERT_EQ(downloader.Download(m_rootPath + "/path", url, "kb/kept.scs"), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/path/kb/kept.scs"), "kept");
+  EXPECT_TRUE(downloader.IsCachePartial(url));
+
+  ASSERT_EQ(downloader.Download(m_rootPath + "/component", url), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/component/kb/changed.scs"), "changed");
+  EXPECT_EQ(ReadFile(m_rootPath + "/component/docs/removed/readme.md"), "removed");
+  EXPECT_FALSE(downloader.IsCachePartial(url));
+
+  // Full cache serves path requests and stays full
+  ASSERT_EQ(downloader.Download(m_rootPath + "/other", url, "removed.txt"), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/other/removed.txt"), "removed");
+  EXPECT_FALSE(downloader.IsCachePartial(url));
+}
+
+TEST_F(ScComponentManagerDownloaderGitTest, MissingSourceFailsPermanently)
+{
+  DownloaderGit downloader(
+      m_rootPath + "/cache", std::make_shared<componentUtils::ProcessRunner>(), std::chrono::milliseconds(60000));
+
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/missing", "file://" + m_rootPath + "/missing"),
+      DownloadStatus::FailedPermanently);
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/path", "file://" + m_sourcePath, "kb/missing.scs"),
+      DownloadStatus::FailedPermanently);
+}
+
+TEST(ScComponentManagerDownloaderGitParseTest, ParseChanges)
+{
+  using namespace std::string_literals;
+
+  std::string const output = "M\0kb/changed.scs\0A\0kb/added.scs\0D\0removed.txt\0"s;
+  std::vector<std::string> changedPaths;
+  std::vector<std::string> removedPaths;
+  DownloaderGit::ParseChanges(output, changedPaths, removedPaths);
+
+  EXPECT_EQ(changedPaths, std::vector<std::string>({"kb/changed.scs", "kb/added.scs"}));
+  EXPECT_EQ(removedPaths, std::vector<std::string>({"removed.txt"}));
+}
@@ -0,0 +1,140 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_component_manager_files_test.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#include "src/manager/downloader/downloader_http.hpp"
+
+namespace
+{
+std::string const SPECIFICATION_CONTENT = "cat_specification <- concept_reusable_component_specification;;";
+
+/**
+ * @brief HTTP server stand-in that serves one file over kept alive connections
+ * and counts accepted connections.
+ */
+class LocalHttpServer
+{
+public:
+  LocalHttpServer()
+  {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(m_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    listen(m_socket, 4);
+
+    socklen_t addressSize = sizeof(address);
+    getsockname(m_socket, reinterpret_cast<sockaddr *>(&address), &addressSize);
+    m_port = ntohs(address.sin_port);
+
+    m_thread = std::thread(&LocalHttpServer::Serve, this);
+  }
+
+  ~LocalHttpServer()
+  {
+    shutdown(m_socket, SHUT_RDWR);
+    close(m_socket);
+    m_thread.join();
+  }
+
+  std::string GetUrl() const
+  {
+    return "http://127.0.0.1:" + std::to_string(m_port);
+  }
+
+  size_t GetConnectionsCount() const
+  {
+    return m_connectionsCount;
+  }
+
+private:
+  int m_socket;
+  uint16_t m_port;
+  std::atomic<size_t> m_connectionsCount{0};
+  std::thread m_thread;
+
+  void Serve()
+  {
+    int connection;
+    while ((connection = accept(m_socket, nullptr, nullptr)) >= 0)
+    {
+      ++m_connectionsCount;
+      std::string request;
+      char buffer[1024];
+      ssize_t readSize;
+      while ((readSize = read(connection, buffer, sizeof(buffer))) > 0)
+      {
+        request.append(buffer, readSize);
+        size_t requestEnd;
+        while ((requestEnd = request.find("\r\n\r\n")) != std::string::npos)
+        {
+          std::string const head = request.substr(0, requestEnd);
+          request.erase(0, requestEnd + 4);
+          bool const isFound = head.rfind("GET /repository/specification.scs ", 0) == 0;
+          std::string const body = isFound ? SPECIFICATION_CONTENT : "";
+          std::string const response = std::string(isFound ? "HTTP/1.1 200 OK" : "HTTP/1.1 404 Not Found") +
+                                       "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+          write(connection, response.data(), response.size());
+        }
+      }
+      close(connection);
+    }
+  }
+};
+}  // namespace
+
+using ScComponentManagerDownloaderHttpTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerDownloaderHttpTest, ReuseConnection)
+{
+  LocalHttpServer server;
+  DownloaderHttp downloader;
+
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/first", server.GetUrl() + "/repository/", "specification.scs"),
+      DownloadStatus::Downloaded);
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/second", server.GetUrl() + "/repository", "specification.scs"),
+      DownloadStatus::Downloaded);
+
+  EXPECT_EQ(ReadFile(m_rootPath + "/first/specification.scs"), SPECIFICATION_CONTENT);
+  EXPECT_EQ(ReadFile(m_rootPath + "/second/specification.scs"), SPECIFICATION_CONTENT);
+  EXPECT_EQ(server.GetConnectionsCount(), 1u);
+}
+
+TEST_F(ScComponentManagerDownloaderHttpTest, MissingFile)
+{
+  LocalHttpServer server;
+  DownloaderHttp downloader;
+
+  EXPECT_EQ(
+      downloader.Download(m_rootPath, server.GetUrl() + "/missing", "specification.scs"),
+      DownloadStatus::FailedPermanently);
+  EXPECT_TRUE(componentUtils::FileUtils::IsDirectoryEmpty(m_rootPath));
+}
+
+TEST_F(ScComponentManagerDownloaderHttpTest, GetFileUrl)
+{
+  EXPECT_EQ(
+      DownloaderHttp::GetFileUrl("https://github.com/MksmOrlov/cat-kb-component.git", "specification.scs"),
+      "https://raw.githubusercontent.com/MksmOrlov/cat-kb-component/HEAD/specification.scs");
+  EXPECT_EQ(
+      DownloaderHttp::GetFileUrl("https://example.com/specifications/", "specification.scs"),
+      "https://example.com/specifications/specification.scs");
+  EXPECT_EQ(
+      DownloaderHttp::GetFileUrl("https://example.com/specification.scs", ""),
+      "https://example.com/specification.scs");
+}
@@ -0,0 +1,66 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_component_manager_files_test.hpp"
+
+#include "src/manager/downloader/downloader_local.hpp"
+#include "src/manager/utils/content_digest.hpp"
+
+using ScComponentManagerDownloaderLocalTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerDownloaderLocalTest, CopySource)
+{
+  WriteFile(m_rootPath + "/mirror/component/kb/component.scs", "component");
+  WriteFile(m_rootPath + "/mirror/component/specification.scs", "specification");
+
+  DownloaderLocal downloader;
+  std::string const url = "file://" + m_rootPath + "/mirror/component/";
+  EXPECT_EQ(downloader.Download(m_rootPath + "/whole", url), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/whole/kb/component.scs"), "component");
+  EXPECT_EQ(ReadFile(m_rootPath + "/whole/specification.scs"), "specification");
+
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/single", m_rootPath + "/mirror/component", "specification.scs"),
+      DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/single/specification.scs"), "specification");
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(m_rootPath + "/single/kb"));
+
+  EXPECT_EQ(downloader.Download(m_rootPath + "/missing", url, "missing.scs"), DownloadStatus::FailedPermanently);
+}
+
+TEST_F(ScComponentManagerDownloaderLocalTest, HashSourceWhileCopying)
+{
+  WriteFile(m_rootPath + "/mirror/component/kb/component.scs", "component");
+  WriteFile(m_rootPath + "/mirror/component/specification.scs", "specification");
+
+  DownloaderLocal downloader;
+  std::string const sourcePath = m_rootPath + "/mirror/component";
+  std::string checksum;
+  EXPECT_EQ(
+      downloader.DownloadWithChecksum(m_rootPath + "/whole", sourcePath, "", checksum),
+      DownloadStatus::Downloaded);
+  EXPECT_EQ(checksum, componentUtils::ContentDigest::GetPathHash(sourcePath));
+  EXPECT_EQ(ReadFile(m_rootPath + "/whole/kb/component.scs"), "component");
+
+  EXPECT_EQ(
+      downloader.DownloadWithChecksum(m_rootPath + "/kb", sourcePath, "kb", checksum),
+      DownloadStatus::Downloaded);
+  EXPECT_EQ(checksum, componentUtils::ContentDigest::GetPathHash(sourcePath + "/kb"));
+
+  EXPECT_EQ(
+      downloader.DownloadWithChecksum(m_rootPath + "/single", sourcePath, "specification.scs", checksum),
+      DownloadStatus::Downloaded);
+  EXPECT_EQ(checksum, componentUtils::ContentDigest::GetPathHash(sourcePath + "/specification.scs"));
+  EXPECT_EQ(ReadFile(m_rootPath + "/single/specification.scs"), "specification");
+}
+
+TEST_F(ScComponentManagerDownloaderLocalTest, GetLocalPath)
+{
+  EXPECT_EQ(DownloaderLocal::GetLocalPath("file:///srv/mirror/component/"), "/srv/mirror/component");
+  EXPECT_EQ(DownloaderLocal::GetLocalPath("/srv/mirror/component"), "/srv/mirror/component");
+  EXPECT_EQ(DownloaderLocal::GetLocalPath("file://host/component"), "");
+  EXPECT_FALSE(DownloaderLocal::IsLocalUrl("https://github.com/MksmOrlov/cat-kb-component"));
+}
@@ -0,0 +1,54 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_component_manager_files_test.hpp"
+
+#include "src/manager/downloader/downloader_tarball.hpp"
+#include "src/manager/utils/process_runner.hpp"
+
+using ScComponentManagerDownloaderTarballTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerDownloaderTarballTest, DownloadArchive)
+{
+  WriteFile(m_rootPath + "/source/component/kb/component.scs", "component");
+  WriteFile(m_rootPath + "/source/component/specification.scs", "specification");
+
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {"tar", "-czf", m_rootPath + "/component.tar.gz", "-C", m_rootPath + "/source", "component"};
+  ASSERT_TRUE(runner.Run(options).IsSuccess());
+
+  DownloaderTarball downloader;
+  std::string const archiveUrl = "file://" + m_rootPath + "/component.tar.gz";
+  EXPECT_EQ(downloader.Download(m_rootPath + "/whole", archiveUrl), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/whole/kb/component.scs"), "component");
+  EXPECT_EQ(ReadFile(m_rootPath + "/whole/specification.scs"), "specification");
+
+  EXPECT_EQ(downloader.Download(m_rootPath + "/single", archiveUrl, "specification.scs"), DownloadStatus::Downloaded);
+  EXPECT_EQ(ReadFile(m_rootPath + "/single/specification.scs"), "specification");
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(m_rootPath + "/single/kb"));
+
+  EXPECT_EQ(downloader.Download(m_rootPath + "/missing", archiveUrl, "missing.scs"), DownloadStatus::FailedPermanently);
+  EXPECT_EQ(
+      downloader.Download(m_rootPath + "/missing", "file://" + m_rootPath + "/missing.tar.gz"),
+      DownloadStatus::FailedPermanently);
+}
+
+TEST_F(ScComponentManagerDownloaderTarballTest, GetArchiveUrl)
+{
+  EXPECT_EQ(
+      DownloaderTarball::GetArchiveUrl("https://github.com/MksmOrlov/cat-kb-component.git", "0123abc"),
+      "https://codeload.github.com/MksmOrlov/cat-kb-component/tar.gz/0123abc");
+  EXPECT_EQ(
+      DownloaderTarball::GetArchiveUrl("https://github.com/MksmOrlov/cat-kb-component/"),
+      "https://codeload.github.com/MksmOrlov/cat-kb-component/tar.gz/HEAD");
+  EXPECT_EQ(
+      DownloaderTarball::GetArchiveUrl("https://example.com/component.tar.gz"), "https://example.com/component.tar.gz");
+
+  EXPECT_TRUE(DownloaderTarball::IsArchiveUrl("https://example.com/component.tar.gz"));
+  EXPECT_TRUE(DownloaderTarball::IsArchiveUrl("https://example.com/component.tgz?token=1"));
+  EXPECT_FALSE(DownloaderTarball::IsArchiveUrl("https://example.com/component"));
+}
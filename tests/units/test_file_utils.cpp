@@ -0,0 +1,113 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+
+#include <fstream>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/file_utils.hpp"
+
+class ScComponentManagerFileUtilsTest : public ScComponentManagerFilesTest
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(ScComponentManagerFilesTest::SetUp());
+    m_sourcePath = m_rootPath + "/source";
+    WriteFile(m_sourcePath + "/specification.scs", "specification");
+    WriteFile(m_sourcePath + "/kb/component.scs", "component");
+  }
+
+  std::string m_sourcePath;
+};
+
+TEST_F(ScComponentManagerFileUtilsTest, CopyDirectory)
+{
+  std::string const targetPath = m_rootPath + "/target";
+
+  EXPECT_TRUE(componentUtils::FileUtils::CopyDirectory(m_sourcePath, targetPath, false));
+  EXPECT_EQ(ReadFile(targetPath + "/specification.scs"), "specification");
+  EXPECT_EQ(ReadFile(targetPath + "/kb/component.scs"), "component");
+
+  WriteFile(targetPath + "/kb/component.scs", "changed");
+  EXPECT_EQ(ReadFile(m_sourcePath + "/kb/component.scs"), "component");
+}
+
+TEST_F(ScComponentManagerFileUtilsTest, ReplaceHardlinkedFile)
+{
+  std::string const targetPath = m_rootPath + "/target";
+  WriteFile(m_rootPath + "/target.scs", "old");
+  ASSERT_TRUE(componentUtils::FileUtils::CopyDirectory(m_sourcePath, targetPath, true));
+
+  EXPECT_TRUE(componentUtils::FileUtils::CopyFile(m_rootPath + "/target.scs", targetPath + "/specification.scs", true));
+  EXPECT_EQ(ReadFile(targetPath + "/specification.scs"), "old");
+  EXPECT_EQ(ReadFile(m_sourcePath + "/specification.scs"), "specification");
+}
+
+TEST_F(ScComponentManagerFileUtilsTest, ReplaceDirectory)
+{
+  std::string const targetPath = m_rootPath + "/target";
+  ASSERT_EQ(mkdir(targetPath.c_str(), 0755), 0);
+  WriteFile(targetPath + "/stale.scs", "stale");
+  WriteFile(targetPath + "/specification.scs", "old");
+
+  EXPECT_TRUE(componentUtils::FileUtils::ReplaceDirectory(m_sourcePath, targetPath, false));
+  EXPECT_EQ(ReadFile(targetPath + "/specification.scs"), "specification");
+  EXPECT_EQ(ReadFile(targetPath + "/kb/component.scs"), "component");
+  EXPECT_FALSE(std::ifstream(targetPath + "/stale.scs").good());
+
+  // Only source and target are left, temporary directories are removed
+  EXPECT_TRUE(componentUtils::FileUtils::RemoveDirectory(m_sourcePath));
+  EXPECT_TRUE(componentUtils::FileUtils::RemoveDirectory(targetPath));
+  EXPECT_TRUE(componentUtils::FileUtils::IsDirectoryEmpty(m_rootPath));
+}
+
+TEST_F(ScComponentManagerFileUtilsTest, KeepDirectoryIfReplaceFails)
+{
+  std::string const targetPath = m_rootPath + "/target";
+  ASSERT_EQ(mkdir(targetPath.c_str(), 0755), 0);
+  WriteFile(targetPath + "/specification.scs", "old");
+
+  EXPECT_FALSE(componentUtils::FileUtils::ReplaceDirectory(m_rootPath + "/missing", targetPath, false));
+  EXPECT_EQ(ReadFile(targetPath + "/specification.scs"), "old");
+}
+
+TEST_F(ScComponentManagerFileUtilsTest, RemoveDirectory)
+{
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectoryEmpty(m_sourcePath));
+  EXPECT_TRUE(componentUtils::FileUtils::RemoveDirectory(m_sourcePath));
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(m_sourcePath));
+  EXPECT_TRUE(componentUtils::FileUtils::IsDirectoryEmpty(m_rootPath));
+}
+
+TEST_F(ScComponentManagerFileUtilsTest, GetFilesInDirectory)
+{
+  WriteFile(m_sourcePath + "/kb/nested/nested.scs", "nested");
+  WriteFile(m_sourcePath + "/kb/component.scs.orig", "backup");
+  WriteFile(m_sourcePath + "/kb/.scs", "hidden");
+  WriteFile(m_sourcePath + "/.git/config.scs", "git");
+
+  std::vector<std::string> const expectedPaths = {
+      m_sourcePath + "/kb/component.scs", m_sourcePath + "/kb/nested/nested.scs", m_sourcePath + "/specification.scs"};
+  EXPECT_EQ(componentUtils::FileUtils::GetFilesInDirectory(m_sourcePath, ".scs"), expectedPaths);
+  EXPECT_TRUE(componentUtils::FileUtils::GetFilesInDirectory(m_rootPath + "/missing", ".scs").empty());
+}
+
+TEST(ScComponentManagerFileUtilsPatternsTest, IsPathMatched)
+{
+  std::vector<std::string> const patterns = {"kb/*.scs", "docs", "tests/*/data.scs"};
+
+  EXPECT_TRUE(componentUtils::FileUtils::IsPathMatched("kb/component.scs", patterns));
+  EXPECT_TRUE(componentUtils::FileUtils::IsPathMatched("kb/nested/component.scs", patterns));
+  EXPECT_TRUE(componentUtils::FileUtils::IsPathMatched("docs/section/section.scs", patterns));
+  EXPECT_TRUE(componentUtils::FileUtils::IsPathMatched("tests/units/data.scs", patterns));
+  EXPECT_FALSE(componentUtils::FileUtils::IsPathMatched("specification.scs", patterns));
+  EXPECT_FALSE(componentUtils::FileUtils::IsPathMatched("documentation/section.scs", patterns));
+  EXPECT_FALSE(componentUtils::FileUtils::IsPathMatched("kb/component.scs", {}));
+}
@@ -0,0 +1,33 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/install_history.hpp"
+
+using ScComponentManagerInstallHistoryTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerInstallHistoryTest, SaveLoad)
+{
+  std::string const historyPath = m_rootPath + "/.install_history";
+
+  componentUtils::InstallHistory history(historyPath);
+  history.Update("cat", {1024, std::chrono::milliseconds(1500), std::chrono::milliseconds(30000)});
+  history.Save();
+  std::ofstream(historyPath, std::ios::app) << "broken line\n";
+
+  componentUtils::InstallHistory loadedHistory(historyPath);
+  loadedHistory.Load();
+  componentUtils::InstallHistoryEntry entry;
+  ASSERT_TRUE(loadedHistory.Find("cat", entry));
+  EXPECT_EQ(entry.downloadedBytes, 1024u);
+  EXPECT_EQ(entry.GetDuration(), std::chrono::milliseconds(31500));
+  EXPECT_FALSE(loadedHistory.Find("broken line", entry));
+  EXPECT_FALSE(loadedHistory.Find("dog", entry));
+}
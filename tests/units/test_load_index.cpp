@@ -0,0 +1,54 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/load_index.hpp"
+
+namespace
+{
+void SetModificationTime(std::string const & path, time_t seconds)
+{
+  struct timespec const times[2] = {{seconds, 0}, {seconds, 0}};
+  ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+}
+}  // namespace
+
+using ScComponentManagerLoadIndexTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerLoadIndexTest, IsChanged)
+{
+  std::string const filePath = m_rootPath + "/component.scs";
+  WriteFile(filePath, "a -> b;;");
+  SetModificationTime(filePath, 1000);
+
+  componentUtils::LoadIndex index(m_rootPath + "/.cache/load_index");
+  componentUtils::LoadIndexEntry entry;
+  ASSERT_TRUE(index.IsChanged(filePath, entry));
+  EXPECT_EQ(entry.size, 8u);
+  EXPECT_FALSE(entry.hash.empty());
+  index.Update(filePath, entry);
+  index.Save();
+
+  componentUtils::LoadIndex loadedIndex(m_rootPath + "/.cache/load_index");
+  loadedIndex.Load();
+  EXPECT_FALSE(loadedIndex.IsChanged(filePath, entry));
+
+  // Touched file with the same content is unchanged
+  SetModificationTime(filePath, 2000);
+  EXPECT_FALSE(loadedIndex.IsChanged(filePath, entry));
+
+  WriteFile(filePath, "a -> c;;");
+  SetModificationTime(filePath, 2000);
+  EXPECT_TRUE(loadedIndex.IsChanged(filePath, entry));
+
+  EXPECT_TRUE(loadedIndex.IsChanged(m_rootPath + "/missing.scs", entry));
+  EXPECT_TRUE(entry.hash.empty());
+}
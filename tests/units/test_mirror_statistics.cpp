@@ -0,0 +1,68 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "src/manager/utils/mirror_statistics.hpp"
+
+namespace
+{
+std::string const FAST_MIRROR = "https://fast.example.com/kb";
+std::string const SLOW_MIRROR = "https://slow.example.com/kb";
+std::string const DEAD_MIRROR = "https://dead.example.com/kb";
+std::string const NEW_MIRROR = "https://new.example.com/kb";
+}  // namespace
+
+TEST(ScComponentManagerMirrorStatisticsTest, OrderByExpectedLatency)
+{
+  componentUtils::MirrorStatistics statistics("");
+  statistics.Update(FAST_MIRROR, true, std::chrono::milliseconds(100));
+  statistics.Update(SLOW_MIRROR, true, std::chrono::milliseconds(5000));
+  statistics.Update(DEAD_MIRROR, false, std::chrono::milliseconds(30000));
+  statistics.Update(DEAD_MIRROR, false, std::chrono::milliseconds(30000));
+
+  EXPECT_EQ(
+      statistics.GetOrder({DEAD_MIRROR, NEW_MIRROR, SLOW_MIRROR, FAST_MIRROR}),
+      std::vector<size_t>({3, 2, 1, 0}));
+  EXPECT_EQ(statistics.GetOrder({NEW_MIRROR + "/first", NEW_MIRROR + "/second"}), std::vector<size_t>({0, 1}));
+}
+
+TEST(ScComponentManagerMirrorStatisticsTest, RecoverAfterFailures)
+{
+  componentUtils::MirrorStatistics statistics("");
+  statistics.Update(SLOW_MIRROR, true, std::chrono::milliseconds(2000));
+  statistics.Update(FAST_MIRROR, false, std::chrono::milliseconds(0));
+  EXPECT_EQ(statistics.GetOrder({FAST_MIRROR, SLOW_MIRROR}), std::vector<size_t>({1, 0}));
+
+  for (size_t i = 0; i < 10; ++i)
+    statistics.Update(FAST_MIRROR, true, std::chrono::milliseconds(100));
+  EXPECT_EQ(statistics.GetOrder({FAST_MIRROR, SLOW_MIRROR}), std::vector<size_t>({0, 1}));
+}
+
+TEST(ScComponentManagerMirrorStatisticsTest, SaveAndLoad)
+{
+  std::string const statisticsPath = "/tmp/sc_component_manager_mirror_statistics_test";
+  {
+    componentUtils::MirrorStatistics statistics(statisticsPath);
+    statistics.Update(FAST_MIRROR, true, std::chrono::milliseconds(100));
+    statistics.Update(FAST_MIRROR, false, std::chrono::milliseconds(0));
+    statistics.Save();
+  }
+
+  componentUtils::MirrorStatistics statistics(statisticsPath);
+  statistics.Load();
+  componentUtils::MirrorEntry entry;
+  ASSERT_TRUE(statistics.Find(FAST_MIRROR, entry));
+  EXPECT_EQ(entry.successesCount, 1u);
+  EXPECT_EQ(entry.failuresCount, 1u);
+  EXPECT_EQ(entry.averageLatency.count(), 100);
+  EXPECT_NEAR(entry.failureRate, 0.3, 1e-6);
+  EXPECT_FALSE(statistics.Find(SLOW_MIRROR, entry));
+
+  std::remove(statisticsPath.c_str());
+}
@@ -0,0 +1,105 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/persistent_store.hpp"
+
+extern "C"
+{
+#include "sc-core/sc-store/sc-fs-storage/sc_file_system.h"
+}
+
+namespace
+{
+struct TestEntry
+{
+  std::string name;
+  int count = 0;
+};
+
+class TestStore : public componentUtils::PersistentStore<TestEntry>
+{
+public:
+  using PersistentStore::PersistentStore;
+
+protected:
+  bool ParseEntry(std::vector<std::string> const & fields, TestEntry & entry) const override
+  {
+    return fields.size() == 2 && componentUtils::TabSeparatedFile::ParseValue(fields[1], entry.count) &&
+           !(entry.name = fields[0]).empty();
+  }
+
+  std::vector<std::string> FormatEntry(TestEntry const & entry) const override
+  {
+    return {entry.name, componentUtils::TabSeparatedFile::FormatValue(entry.count)};
+  }
+};
+}  // namespace
+
+using ScComponentManagerPersistentStoreTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerPersistentStoreTest, SaveLoad)
+{
+  std::string const storePath = m_rootPath + "/cache/store";
+
+  TestStore missingStore(storePath);
+  missingStore.Load();
+  TestEntry entry;
+  EXPECT_FALSE(missingStore.Find("first", entry));
+
+  TestStore store(storePath);
+  store.Update("first", {"name", 1});
+  store.Update("second", {"other", -2});
+  store.Update("removed", {"name", 3});
+  store.Remove("removed");
+  ASSERT_TRUE(store.Save());
+  std::ofstream(storePath, std::ios::app) << "broken\tname\tcount\n\nthird\t\t3\n";
+
+  TestStore loadedStore(storePath);
+  loadedStore.Load();
+  ASSERT_TRUE(loadedStore.Find("first", entry));
+  EXPECT_EQ(entry.name, "name");
+  EXPECT_EQ(entry.count, 1);
+  ASSERT_TRUE(loadedStore.Find("second", entry));
+  EXPECT_EQ(entry.count, -2);
+  EXPECT_FALSE(loadedStore.Find("removed", entry));
+  EXPECT_FALSE(loadedStore.Find("broken", entry));
+  EXPECT_FALSE(loadedStore.Find("third", entry));
+}
+
+TEST_F(ScComponentManagerPersistentStoreTest, KeepFileIfSaveFails)
+{
+  std::string const storePath = m_rootPath + "/store";
+
+  TestStore store(storePath);
+  store.Update("first", {"name", 1});
+  ASSERT_TRUE(store.Save());
+
+  // Temporary file can't be created in place of directory
+  ASSERT_TRUE(sc_fs_mkdirs((storePath + ".tmp").c_str()));
+  store.Update("first", {"name", 2});
+  EXPECT_FALSE(store.Save());
+
+  TestStore loadedStore(storePath);
+  loadedStore.Load();
+  TestEntry entry;
+  ASSERT_TRUE(loadedStore.Find("first", entry));
+  EXPECT_EQ(entry.count, 1);
+}
+
+TEST_F(ScComponentManagerPersistentStoreTest, ReadEmptyFields)
+{
+  std::string const filePath = m_rootPath + "/lines";
+
+  ASSERT_TRUE(componentUtils::TabSeparatedFile::Write(filePath, {{"a", "", "c", ""}, {"single"}}));
+  EXPECT_EQ(
+      componentUtils::TabSeparatedFile::Read(filePath),
+      std::vector<std::vector<std::string>>({{"a", "", "c", ""}, {"single"}}));
+}
@@ -0,0 +1,116 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/manager/utils/process_runner.hpp"
+
+namespace
+{
+componentUtils::ProcessOptions GetOptions(std::vector<std::string> const & arguments)
+{
+  componentUtils::ProcessOptions options;
+  options.arguments = arguments;
+  return options;
+}
+}  // namespace
+
+TEST(ScComponentManagerProcessRunnerTest, ExitCode)
+{
+  componentUtils::ProcessRunner runner;
+
+  EXPECT_TRUE(runner.Run(GetOptions({"true"})).IsSuccess());
+
+  componentUtils::ProcessResult const result = runner.Run(GetOptions({"sh", "-c", "echo failed >&2; exit 3"}));
+  EXPECT_TRUE(result.isStarted);
+  EXPECT_FALSE(result.IsSuccess());
+  EXPECT_EQ(result.exitCode, 3);
+  EXPECT_EQ(result.errorOutput, "failed\n");
+}
+
+TEST(ScComponentManagerProcessRunnerTest, MissingProgram)
+{
+  componentUtils::ProcessRunner runner;
+
+  componentUtils::ProcessResult const result = runner.Run(GetOptions({"sc-component-manager-missing-program"}));
+  EXPECT_FALSE(result.IsSuccess());
+}
+
+TEST(ScComponentManagerProcessRunnerTest, CaptureOutputInWorkingDirectory)
+{
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {"pwd"};
+  options.workingDirectory = "/tmp";
+  options.isOutputCaptured = true;
+
+  componentUtils::ProcessResult const result = runner.Run(options);
+  EXPECT_TRUE(result.IsSuccess());
+  EXPECT_EQ(result.output, "/tmp\n");
+}
+
+TEST(ScComponentManagerProcessRunnerTest, Timeout)
+{
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {"sleep", "10"};
+  options.timeout = std::chrono::milliseconds(100);
+
+  auto const begin = std::chrono::steady_clock::now();
+  componentUtils::ProcessResult const result = runner.Run(options);
+  EXPECT_TRUE(result.isTimedOut);
+  EXPECT_FALSE(result.IsSuccess());
+  EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(5));
+}
+
+TEST(ScComponentManagerProcessRunnerTest, ConcurrentProcesses)
+{
+  size_t constexpr kProcessesCount = 16;
+  componentUtils::ProcessRunner runner;
+
+  auto const begin = std::chrono::steady_clock::now();
+  std::vector<std::future<componentUtils::ProcessResult>> results;
+  for (size_t i = 0; i < kProcessesCount; ++i)
+    results.push_back(runner.Start(GetOptions({"sh", "-c", "sleep 0.2; exit " + std::to_string(i)})));
+
+  for (size_t i = 0; i < kProcessesCount; ++i)
+    EXPECT_EQ(results[i].get().exitCode, static_cast<int>(i));
+  EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(2));
+}
+
+TEST(ScComponentManagerProcessRunnerTest, ConsumeOutput)
+{
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {"sh", "-c", "printf first; printf ' second'"};
+  std::string output;
+  options.outputConsumer = [&output](char const * data, size_t size)
+  {
+    output.append(data, size);
+    return true;
+  };
+
+  componentUtils::ProcessResult const result = runner.Run(options);
+  EXPECT_TRUE(result.IsSuccess());
+  EXPECT_TRUE(result.output.empty());
+  EXPECT_EQ(output, "first second");
+}
+
+TEST(ScComponentManagerProcessRunnerTest, RejectOutput)
+{
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {"yes"};
+  options.timeout = std::chrono::milliseconds(5000);
+  options.outputConsumer = [](char const *, size_t)
+  {
+    return false;
+  };
+
+  componentUtils::ProcessResult const result = runner.Run(options);
+  EXPECT_FALSE(result.IsSuccess());
+  EXPECT_FALSE(result.isTimedOut);
+}
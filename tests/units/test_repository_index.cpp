@@ -0,0 +1,44 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/manager/utils/repository_index.hpp"
+
+TEST(ScComponentManagerRepositoryIndexTest, ParseEntries)
+{
+  std::string const catSpecification = "cat_specification <- concept_reusable_component_specification;;\n";
+  std::string const dogSpecification = "dog_specification <- concept_reusable_component_specification;;";
+
+  componentUtils::RepositoryIndex index;
+  EXPECT_EQ(
+      index.Parse(
+          componentUtils::RepositoryIndex::MakeEntry("cat_specification", catSpecification) +
+          componentUtils::RepositoryIndex::MakeEntry("dog_specification", dogSpecification)),
+      (size_t)2);
+
+  componentUtils::RepositoryIndexEntry entry;
+  EXPECT_TRUE(index.Find("cat_specification", entry));
+  EXPECT_EQ(entry.content, catSpecification);
+  EXPECT_TRUE(index.Find("dog_specification", entry));
+  EXPECT_EQ(entry.content, dogSpecification + "\n");
+  EXPECT_FALSE(index.Find("unknown_specification", entry));
+}
+
+TEST(ScComponentManagerRepositoryIndexTest, SkipDamagedEntries)
+{
+  std::string indexContent =
+      componentUtils::RepositoryIndex::MakeEntry("cat_specification", "cat_specification -> concept_cat;;\n");
+  indexContent += "@specification dog_specification 0000\ndog_specification -> concept_dog;;\n";
+  indexContent += "@specification\n";
+
+  componentUtils::RepositoryIndex index;
+  EXPECT_EQ(index.Parse(indexContent), (size_t)1);
+
+  componentUtils::RepositoryIndexEntry entry;
+  EXPECT_TRUE(index.Find("cat_specification", entry));
+  EXPECT_FALSE(index.Find("dog_specification", entry));
+}
@@ -0,0 +1,95 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/scs_cache.hpp"
+
+namespace
+{
+componentUtils::ScsTriples MakeTriples()
+{
+  componentUtils::ScsTriples triples;
+
+  componentUtils::ScsElement node;
+  node.type = 0x21;
+  node.systemIdtf = "concept_component";
+  triples.elements.push_back(node);
+
+  componentUtils::ScsElement link;
+  link.type = 0x22;
+  link.content = std::string("content with\0zero", 17);
+  triples.elements.push_back(link);
+
+  componentUtils::ScsElement edge;
+  edge.type = 0x2080;
+  edge.sourceIndex = 0;
+  edge.targetIndex = 1;
+  triples.elements.push_back(edge);
+
+  return triples;
+}
+
+void ExpectEqual(componentUtils::ScsTriples const & expected, componentUtils::ScsTriples const & actual)
+{
+  EXPECT_EQ(actual.scsText, expected.scsText);
+  ASSERT_EQ(actual.elements.size(), expected.elements.size());
+  for (size_t i = 0; i < expected.elements.size(); ++i)
+  {
+    EXPECT_EQ(actual.elements[i].type, expected.elements[i].type);
+    EXPECT_EQ(actual.elements[i].systemIdtf, expected.elements[i].systemIdtf);
+    EXPECT_EQ(actual.elements[i].content, expected.elements[i].content);
+    EXPECT_EQ(actual.elements[i].sourceIndex, expected.elements[i].sourceIndex);
+    EXPECT_EQ(actual.elements[i].targetIndex, expected.elements[i].targetIndex);
+  }
+}
+}  // namespace
+
+using ScComponentManagerScsCacheTest = ScComponentManagerFilesTest;
+
+TEST_F(ScComponentManagerScsCacheTest, Serialize)
+{
+  componentUtils::ScsTriples const triples = MakeTriples();
+  std::string const data = componentUtils::ScsCache::Serialize(triples);
+
+  componentUtils::ScsTriples readTriples;
+  ASSERT_TRUE(componentUtils::ScsCache::Deserialize(data.data(), data.size(), readTriples));
+  ExpectEqual(triples, readTriples);
+
+  EXPECT_FALSE(componentUtils::ScsCache::Deserialize(data.data(), data.size() - 1, readTriples));
+  EXPECT_FALSE(componentUtils::ScsCache::Deserialize(data.data(), 4, readTriples));
+
+  std::string brokenData = data;
+  brokenData[0] = 'X';
+  EXPECT_FALSE(componentUtils::ScsCache::Deserialize(brokenData.data(), brokenData.size(), readTriples));
+}
+
+TEST_F(ScComponentManagerScsCacheTest, FindStored)
+{
+  componentUtils::ScsCache const cache(m_rootPath + "/scs");
+  componentUtils::ScsTriples readTriples;
+  EXPECT_FALSE(cache.Find("0123456789abcdef", readTriples));
+
+  componentUtils::ScsTriples textTriples;
+  textTriples.scsText = "a -> b;;";
+  cache.Store("0123456789abcdef", MakeTriples());
+  cache.Store("fedcba9876543210", textTriples);
+
+  ASSERT_TRUE(cache.Find("0123456789abcdef", readTriples));
+  ExpectEqual(MakeTriples(), readTriples);
+  ASSERT_TRUE(cache.Find("fedcba9876543210", readTriples));
+  ExpectEqual(textTriples, readTriples);
+
+  std::ofstream(m_rootPath + "/scs/01/0123456789abcdef", std::ios::trunc) << "broken";
+  EXPECT_FALSE(cache.Find("0123456789abcdef", readTriples));
+
+  componentUtils::ScsCache const disabledCache;
+  disabledCache.Store("0123456789abcdef", MakeTriples());
+  EXPECT_FALSE(disabledCache.Find("0123456789abcdef", readTriples));
+}
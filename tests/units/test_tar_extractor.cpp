@@ -0,0 +1,124 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+
+#include "sc_component_manager_files_test.hpp"
+#include "src/manager/utils/content_digest.hpp"
+#include "src/manager/utils/file_utils.hpp"
+#include "src/manager/utils/hasher.hpp"
+#include "src/manager/utils/process_runner.hpp"
+#include "src/manager/utils/tar_extractor.hpp"
+
+namespace
+{
+std::string const LONG_DIRECTORY =
+    "kb/section_with_very_long_name_that_does_not_fit_into_ustar_name_field/"
+    "subsection_with_very_long_name_that_does_not_fit_too";
+}  // namespace
+
+class ScComponentManagerTarExtractorTest : public ScComponentManagerFilesTest
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(ScComponentManagerFilesTest::SetUp());
+
+    std::string const sourcePath = m_rootPath + "/source/component-0123abc";
+    std::string const longPath = sourcePath + "/" + LONG_DIRECTORY;
+    WriteFile(sourcePath + "/kb/component.scs", "component");
+    WriteFile(longPath + "/section.scs", "section");
+    WriteFile(sourcePath + "/docs/readme.md", "readme");
+    WriteFile(sourcePath + "/install.sh", "#!/bin/sh\n");
+    chmod((sourcePath + "/install.sh").c_str(), 0755);
+
+    componentUtils::ProcessRunner runner;
+    componentUtils::ProcessOptions options;
+    options.arguments = {
+        "tar", "--format=pax", "-czf", m_rootPath + "/archive.tar.gz", "-C", m_rootPath + "/source", "."};
+    ASSERT_TRUE(runner.Run(options).IsSuccess());
+    m_archive = ReadFile(m_rootPath + "/archive.tar.gz");
+  }
+
+  bool Extract(
+      std::string const & targetPath,
+      std::string const & includedPath,
+      size_t chunkSize,
+      std::string * contentHash = nullptr)
+  {
+    componentUtils::TarExtractor extractor(targetPath, includedPath);
+    for (size_t offset = 0; offset < m_archive.size(); offset += chunkSize)
+    {
+      if (!extractor.Write(m_archive.data() + offset, std::min(chunkSize, m_archive.size() - offset)))
+        return false;
+    }
+
+    if (contentHash != nullptr)
+      *contentHash = extractor.GetContentHash();
+    return extractor.Finish();
+  }
+
+  std::string m_archive;
+};
+
+TEST_F(ScComponentManagerTarExtractorTest, ExtractWholeArchive)
+{
+  std::string const targetPath = m_rootPath + "/target";
+  ASSERT_TRUE(Extract(targetPath, "", 7));
+
+  EXPECT_EQ(ReadFile(targetPath + "/kb/component.scs"), "component");
+  EXPECT_EQ(ReadFile(targetPath + "/" + LONG_DIRECTORY + "/section.scs"), "section");
+  EXPECT_EQ(ReadFile(targetPath + "/docs/readme.md"), "readme");
+
+  struct stat scriptStat = {};
+  ASSERT_EQ(stat((targetPath + "/install.sh").c_str(), &scriptStat), 0);
+  EXPECT_TRUE(scriptStat.st_mode & S_IXUSR);
+}
+
+TEST_F(ScComponentManagerTarExtractorTest, ExtractIncludedPath)
+{
+  std::string const targetPath = m_rootPath + "/target";
+  ASSERT_TRUE(Extract(targetPath, "kb/", 4096));
+
+  EXPECT_EQ(ReadFile(targetPath + "/kb/component.scs"), "component");
+  EXPECT_EQ(ReadFile(targetPath + "/" + LONG_DIRECTORY + "/section.scs"), "section");
+  EXPECT_FALSE(componentUtils::FileUtils::IsDirectory(targetPath + "/docs"));
+  EXPECT_EQ(componentUtils::FileUtils::GetSize(targetPath + "/install.sh"), 0u);
+}
+
+TEST_F(ScComponentManagerTarExtractorTest, IncompleteArchive)
+{
+  m_archive.resize(m_archive.size() / 2);
+  EXPECT_FALSE(Extract(m_rootPath + "/target", "", 4096));
+}
+
+TEST_F(ScComponentManagerTarExtractorTest, ContentHash)
+{
+  std::string const sourcePath = m_rootPath + "/source/component-0123abc";
+  std::string const targetPath = m_rootPath + "/target";
+  std::string contentHash;
+  ASSERT_TRUE(Extract(targetPath, "", 4096, &contentHash));
+
+  // Checksum of directory can be computed by standard tools
+  componentUtils::ProcessRunner runner;
+  componentUtils::ProcessOptions options;
+  options.arguments = {
+      "sh",
+      "-c",
+      "cd " + sourcePath +
+          " && find . -type f -printf '%P\\n' | LC_ALL=C sort | xargs -d '\\n' sha256sum | sha256sum | cut -c1-64"};
+  options.isOutputCaptured = true;
+  componentUtils::ProcessResult const result = runner.Run(options);
+  ASSERT_TRUE(result.IsSuccess());
+  EXPECT_EQ(contentHash + "\n", result.output);
+  EXPECT_EQ(componentUtils::ContentDigest::GetPathHash(targetPath), contentHash);
+
+  std::string fileHash;
+  ASSERT_TRUE(Extract(m_rootPath + "/file", "kb/component.scs", 4096, &fileHash));
+  EXPECT_EQ(fileHash, componentUtils::Hasher::GetStringHash("component"));
+}
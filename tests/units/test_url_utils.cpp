@@ -0,0 +1,51 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/manager/utils/sc_component_utils.hpp"
+
+TEST(ScComponentManagerUrlUtilsTest, NormalizeEqualUrls)
+{
+  std::string const url = "https://github.com/mksmorlov/cat-kb-component";
+
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl(url), url);
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl("https://github.com/MksmOrlov/cat-kb-component/"), url);
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl("https://github.com/MksmOrlov/cat-kb-component.git"), url);
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl(" HTTPS://www.GitHub.com/MksmOrlov/cat-kb-component\n"), url);
+}
+
+TEST(ScComponentManagerUrlUtilsTest, NormalizeDifferentUrls)
+{
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl("https://Example.com/Path/File/"), "https://example.com/Path/File");
+  EXPECT_NE(
+      componentUtils::UrlUtils::NormalizeUrl("https://github.com/ostis-ai/ims.ostis.kb"),
+      componentUtils::UrlUtils::NormalizeUrl("https://github.com/ostis-ai/ims.ostis.kb-tools"));
+  EXPECT_EQ(componentUtils::UrlUtils::NormalizeUrl(""), "");
+}
+
+TEST(ScComponentManagerUrlUtilsTest, GetHost)
+{
+  EXPECT_EQ(componentUtils::UrlUtils::GetHost("https://github.com/ostis-ai/ims.ostis.kb"), "github.com");
+  EXPECT_EQ(componentUtils::UrlUtils::GetHost("HTTPS://www.Example.com:8080/path"), "example.com:8080");
+  EXPECT_EQ(componentUtils::UrlUtils::GetHost("https://user@example.com"), "example.com");
+  EXPECT_EQ(componentUtils::UrlUtils::GetHost("example.com/path"), "");
+}
+
+TEST(ScComponentManagerUrlUtilsTest, GetMirrorUrl)
+{
+  std::vector<std::string> const prefixes = {"https://github.com/", "https://example.com/files"};
+
+  EXPECT_EQ(
+      componentUtils::UrlUtils::GetMirrorUrl(
+          "https://github.com/MksmOrlov/cat-kb-component.git", "/srv/mirror/", prefixes),
+      "file:///srv/mirror/MksmOrlov/cat-kb-component");
+  EXPECT_EQ(
+      componentUtils::UrlUtils::GetMirrorUrl(" https://example.com/files/kb/\n", "/srv/mirror", prefixes),
+      "file:///srv/mirror/kb");
+  EXPECT_EQ(componentUtils::UrlUtils::GetMirrorUrl("https://example.com/other", "/srv/mirror", prefixes), "");
+  EXPECT_EQ(componentUtils::UrlUtils::GetMirrorUrl("https://github.com/ostis-ai/ims.ostis.kb", "", prefixes), "");
+}